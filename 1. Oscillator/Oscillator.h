@@ -2,6 +2,8 @@
 
 #include "Phasor.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <juce_core/juce_core.h>
 
@@ -10,9 +12,38 @@ template<typename SampleType>
 class Shaper
 {
 public:
+    virtual ~Shaper() = default;
+
     virtual SampleType perform(const SampleType& in) {
         return in;
     }
+
+    //Shape a block of phase values in place
+    //Overriding this lets a shaper run its whole block behind a single virtual call,
+    // so the per-sample body can be inlined and vectorized
+    virtual void process(SampleType* buffer, size_t numSamples) {
+        //The identity function leaves the block untouched
+        (void) buffer;
+        (void) numSamples;
+    }
+
+    //Called by the oscillator whenever the distance the phase moves each sample changes
+    //Shapers that depend on the oscillator's frequency, like band-limited ones, can override this
+    virtual void setPhaseVelocity(const SampleType& newPhaseVelocity) {
+        (void) newPhaseVelocity;
+    }
+
+    //Shape a block of phase values in place, where phaseVelocities holds how far the phase moves from each sample
+    //By default the whole block is shaped with the fastest of those velocities
+    //Shapers that can change their velocity every sample, like the PolyBLEP ones, override this.
+    // Either way, the oscillator sets the velocity back with setPhaseVelocity afterwards
+    virtual void processModulated(SampleType* buffer, const SampleType* phaseVelocities, size_t numSamples) {
+        auto fastestVelocity = SampleType{0};
+        for (size_t i = 0; i < numSamples; ++i)
+            fastestVelocity = std::max(fastestVelocity, std::abs(phaseVelocities[i]));
+        setPhaseVelocity(fastestVelocity);
+        process(buffer, numSamples);
+    }
 };
 
 //Semantically, our Shaper is an identity function, so let's create an alias for it
@@ -27,6 +58,11 @@ public:
     virtual SampleType perform(const SampleType& in) override {
         return std::sin(in*juce::MathConstants<SampleType>::twoPi);
     }
+
+    virtual void process(SampleType* buffer, size_t numSamples) override {
+        for (size_t i = 0; i < numSamples; ++i)
+            buffer[i] = SinShaper::perform(buffer[i]);
+    }
 };
 
 //Triangle wave shaper
@@ -46,6 +82,11 @@ public:
         else
             return SampleType{ 4 }*in - SampleType{ 4 };
     }
+
+    virtual void process(SampleType* buffer, size_t numSamples) override {
+        for (size_t i = 0; i < numSamples; ++i)
+            buffer[i] = TriShaper::perform(buffer[i]);
+    }
 };
 
 //Square wave shaper
@@ -63,6 +104,11 @@ public:
         return isHigh
                +(SampleType{1}-isHigh)*SampleType{-1};
     }
+
+    virtual void process(SampleType* buffer, size_t numSamples) override {
+        for (size_t i = 0; i < numSamples; ++i)
+            buffer[i] = SquareShaper::perform(buffer[i]);
+    }
 };
 
 //Sawtooth wave shaper
@@ -73,18 +119,25 @@ public:
     virtual SampleType perform(const SampleType& in) override {
         return in*SampleType{2}-SampleType{1};
     }
+
+    virtual void process(SampleType* buffer, size_t numSamples) override {
+        for (size_t i = 0; i < numSamples; ++i)
+            buffer[i] = SawShaper::perform(buffer[i]);
+    }
 };
 
 //An oscillator class that can change frequency and sample rate, and be synced
 // By default it uses a shaper that simply returns the value of the phaser
 // By calling setWaveform, it is possible to a class derived from Shaper<T> to change the waveform
-template<typename SampleType>
+// The phasor's accumulation strategy can be picked with the second template argument
+template<typename SampleType, PhaseAccumulation Accumulation = PhaseAccumulation::Index>
 class Oscillator
 {
     using ShaperType = Shaper<SampleType>;
 public:
     void setSampleRate(const SampleType& newPerformRate) noexcept {
         phasor.setSampleRate(newPerformRate);
+        shaper->setPhaseVelocity(phasor.getPhaseVelocity());
     }
 
     void reset() noexcept {
@@ -93,6 +146,15 @@ public:
 
     void setFrequency(const SampleType& newFrequency) noexcept {
         phasor.setFrequency(newFrequency);
+        shaper->setPhaseVelocity(phasor.getPhaseVelocity());
+    }
+
+    //Glide to a new frequency over numSamples
+    //While it ramps, the shaper is given the faster of the phase velocities either side of each sample or block it shapes,
+    // so shapers that band-limit themselves stay alias free, as they do for frequency modulation
+    void setTargetFrequency(const SampleType& newFrequency, size_t numSamples) noexcept {
+        phasor.setTargetFrequency(newFrequency, numSamples);
+        shaper->setPhaseVelocity(phasor.getPhaseVelocity());
     }
 
     void setPhase(const SampleType& newPhase) noexcept {
@@ -101,6 +163,7 @@ public:
 
     void setWaveform(std::unique_ptr<ShaperType>&& newShaper) noexcept {
         shaper.swap(newShaper);
+        shaper->setPhaseVelocity(phasor.getPhaseVelocity());
     }
 
     const auto& getWaveform() const noexcept {
@@ -112,9 +175,100 @@ public:
         return perform();
     }
 
-    SampleType perform() noexcept { return shaper->perform(phasor.perform()); }
+    SampleType perform() noexcept {
+        if (!phasor.isRamping())
+            return shaper->perform(phasor.perform());
+
+        const auto startVelocity = phasor.getPhaseVelocity();
+        const auto phase = phasor.perform();
+        auto output = SampleType{0};
+        shapeRamp(startVelocity, [this, &phase, &output] { output = shaper->perform(phase); });
+        return output;
+    }
+
+    //Fill a block with the oscillator's output
+    // The phasor writes the phase for the whole block, and then the shaper is dispatched once to shape it
+    void process(SampleType* buffer, size_t numSamples) noexcept {
+        if (!phasor.isRamping()) {
+            phasor.process(buffer, numSamples);
+            shaper->process(buffer, numSamples);
+            return;
+        }
+
+        const auto startVelocity = phasor.getPhaseVelocity();
+        phasor.process(buffer, numSamples);
+        shapeRamp(startVelocity, [this, buffer, numSamples] { shaper->process(buffer, numSamples); });
+    }
+
+    //Fill a block with the oscillator's output, frequency modulated by a separate frequency for every sample
+    // The shaper is given the phase velocity of every sample through Shaper::processModulated,
+    // so PolyBLEP shapers size each correction to the sample it's on
+    //frequencies and buffer can be the same buffer
+    void process(const SampleType* frequencies, SampleType* buffer, size_t numSamples) noexcept {
+        //The phases may overwrite the frequencies, so each chunk's velocities are taken before its phases are written
+        std::array<SampleType, modulationChunkSize> velocities;
+        for (size_t start = 0; start < numSamples; start += modulationChunkSize) {
+            const auto chunkSize = std::min(modulationChunkSize, numSamples-start);
+            for (size_t i = 0; i < chunkSize; ++i)
+                velocities[i] = std::abs(phasor.getPhaseVelocity(frequencies[start+i]));
+
+            phasor.process(frequencies+start, buffer+start, chunkSize);
+            shaper->processModulated(buffer+start, velocities.data(), chunkSize);
+        }
+        shaper->setPhaseVelocity(phasor.getPhaseVelocity());
+    }
+
+    //Fill a block with the oscillator's output, hard synced to a master phasor's events
+    // See Phasor::processSynced. The oscillator restarts its cycle at each event
+    //Hard sync makes a jump in the waveform at each event. If smoothJumps is true, each jump is smoothed with a PolyBLEP
+    // across the samples either side of it. The size of a jump is measured with the shaper, so this is meant for the naive shapers,
+    // and it assumes the frequency stays the same for the whole block
+    //A jump just before the first sample of the block can only be smoothed on the samples after it
+    void processSynced(SampleType* buffer, size_t numSamples, const SyncEvent<SampleType>* events, size_t numEvents,
+                       bool smoothJumps = false) noexcept {
+        const auto phaseBeforeBlock = phasor.getPhase();
+        phasor.processSynced(buffer, numSamples, events, numEvents);
+        shaper->process(buffer, numSamples);
+
+        if (!smoothJumps)
+            return;
+
+        const auto velocity = phasor.getPhaseVelocity();
+        const auto restartValue = shaper->perform(SampleType{0});
+        for (size_t i = 0; i < numEvents; ++i) {
+            const auto index = events[i].sampleIndex;
+            const auto fraction = events[i].fraction;
+
+            //Work out where the phase had got to when the master wrapped, from the last event or the start of the block
+            auto phaseAtSync = i == 0
+                             ? phaseBeforeBlock+(static_cast<SampleType>(index)-fraction)*velocity
+                             : (static_cast<SampleType>(index-events[i-1].sampleIndex)+events[i-1].fraction-fraction)*velocity;
+            phaseAtSync -= std::floor(phaseAtSync);
+            phaseAtSync = phaseAtSync < SampleType{1} ? phaseAtSync : SampleType{0};
+
+            //This is the same correction as polyBlep, which is for a jump of 2
+            const auto halfJump = (restartValue-shaper->perform(phaseAtSync))/SampleType{2};
+            buffer[index] -= halfJump*(SampleType{1}-fraction)*(SampleType{1}-fraction);
+            if (index > 0)
+                buffer[index-1] += halfJump*fraction*fraction;
+        }
+    }
 
 private:
-    Phasor<SampleType> phasor{};
+    //How many per-sample velocities a frequency modulated block is shaped with at a time
+    static constexpr size_t modulationChunkSize = 64;
+
+    Phasor<SampleType, Accumulation> phasor{};
     std::unique_ptr<ShaperType> shaper = std::make_unique<ShaperType>();
+
+    //Shape what the phasor has just rendered during a ramp, with the faster of its velocities at the start and the end.
+    // The velocity moves in a straight line, so one of those is the fastest it went
+    //Afterwards the shaper is left with the velocity the phasor carries on at
+    template<typename Shape>
+    void shapeRamp(const SampleType& startVelocity, Shape&& shape) noexcept {
+        const auto endVelocity = phasor.getPhaseVelocity();
+        shaper->setPhaseVelocity(std::abs(startVelocity) > std::abs(endVelocity) ? startVelocity : endVelocity);
+        shape();
+        shaper->setPhaseVelocity(endVelocity);
+    }
 };
\ No newline at end of file
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Oscillator.h"
+
+#include <array>
+#include <juce_dsp/juce_dsp.h>
+
+//A bank of oscillators that share a sample rate and a waveform type
+// Instead of holding a phasor per voice, the bank keeps the phase and phase increment of every voice in contiguous arrays,
+// and advances them with SIMD registers, several voices at a time.
+// Like the incremental phasor, phases are accumulated in double precision and wrapped by subtracting 1.
+// The shapers are called non-virtually in a loop of their own, so each shaper's body is compiled straight into
+// a loop over the voices that the compiler can vectorize. Whether it does depends on the shaper- with GCC, the saw and square
+// vectorize at -O3, and with -Ofast, which the release build uses, so do the sin, triangle and PolyBLEP shapers
+//The state for a bank of thousands of voices is large, so allocate those on the heap rather than the stack
+template<typename SampleType, size_t NumVoices, template<typename> class ShaperTemplate = Shaper>
+class OscillatorBank
+{
+    using PhaseRegister = juce::dsp::SIMDRegister<double>;
+
+    static constexpr size_t NumLanes = PhaseRegister::SIMDNumElements;
+    static constexpr size_t NumRegisters = (NumVoices+NumLanes-1)/NumLanes;
+    //Pad the phase arrays to a whole number of registers, so the SIMD loop never needs a scalar tail
+    static constexpr size_t PaddedSize = NumRegisters*NumLanes;
+
+public:
+    using ShaperType = ShaperTemplate<SampleType>;
+
+    static constexpr auto Size = NumVoices;
+
+    void setSampleRate(const SampleType& newPerformRate) noexcept {
+        sampleRate = newPerformRate;
+        for (size_t voice = 0; voice < NumVoices; ++voice)
+            updatePhase(voice);
+    }
+
+    void reset() noexcept {
+        std::fill(phases.begin(), phases.end(), 0.0);
+    }
+
+    void setFrequency(size_t voice, const SampleType& newFrequency) noexcept {
+        frequencies[voice] = newFrequency;
+        updatePhase(voice);
+    }
+
+    void setPhase(size_t voice, const SampleType& newPhase) noexcept {
+        phases[voice] = std::fmod(static_cast<double>(newPhase), 1.0);
+        if (phases[voice] < 0.0)
+            phases[voice] += 1.0;
+    }
+
+    void setWaveform(size_t voice, ShaperType newShaper) noexcept {
+        shapers[voice] = std::move(newShaper);
+        shapers[voice].ShaperType::setPhaseVelocity(static_cast<SampleType>(velocities[voice]));
+    }
+
+    constexpr const auto& getWaveform(size_t voice) const noexcept {
+        return shapers[voice];
+    }
+
+    //Gets the current value of every voice, and then advances each voice's phase
+    const auto& perform() noexcept {
+        //Narrow every phase first, and then shape them all in place
+        //Neither loop branches per voice, so the compiler can vectorize each of them, as far as the shaper's body allows
+        for (size_t voice = 0; voice < NumVoices; ++voice) {
+            const auto phase = static_cast<SampleType>(phases[voice]);
+            //A phase just below 1 can round up to 1 when it's narrowed to a float, so wrap it in that case
+            outputs[voice] = phase-static_cast<SampleType>(phase >= SampleType{1});
+        }
+        for (size_t voice = 0; voice < NumVoices; ++voice)
+            outputs[voice] = shapers[voice].ShaperType::perform(outputs[voice]);
+
+        const auto one = PhaseRegister::expand(1.0);
+        for (size_t i = 0; i < PaddedSize; i += NumLanes) {
+            auto phase = PhaseRegister::fromRawArray(phases.data()+i);
+            phase += PhaseRegister::fromRawArray(velocities.data()+i);
+            //Subtract 1 from every lane that has gone past 1
+            phase -= one & PhaseRegister::greaterThanOrEqual(phase, one);
+            phase.copyToRawArray(phases.data()+i);
+        }
+
+        return outputs;
+    }
+
+    //Fill one buffer per voice with the next numSamples values of that voice
+    void process(SampleType* const* voiceBuffers, size_t numSamples) noexcept {
+        for (size_t i = 0; i < numSamples; ++i) {
+            const auto& frame = perform();
+            for (size_t voice = 0; voice < NumVoices; ++voice)
+                voiceBuffers[voice][i] = frame[voice];
+        }
+    }
+
+private:
+    alignas(PhaseRegister::SIMDRegisterSize) std::array<double, PaddedSize> phases{};
+    alignas(PhaseRegister::SIMDRegisterSize) std::array<double, PaddedSize> velocities{};
+
+    std::array<SampleType, NumVoices> frequencies{}, outputs{};
+    SampleType sampleRate{44100};
+
+    std::array<ShaperType, NumVoices> shapers{};
+
+    //Use the same increment as an incremental phasor, kept between 0 and 1 so a single subtraction wraps it
+    void updatePhase(size_t voice) noexcept {
+        velocities[voice] = std::fmod(static_cast<double>(frequencies[voice]/sampleRate), 1.0);
+        if (velocities[voice] < 0.0)
+            velocities[voice] += 1.0;
+
+        shapers[voice].ShaperType::setPhaseVelocity(static_cast<SampleType>(velocities[voice]));
+    }
+};
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "OscillatorBank.h"
+
+#include <catch2/catch.hpp>
+
+#include "OscillatorUtilities.h"
+#include "OscillatorTestConstants.h"
+#include "../Utilities/DecibelMatchers.h"
+#include "../Utilities/Random.h"
+
+//Checks that every voice of a bank matches a separate oscillator with the same settings
+template<typename T, template<typename> class ShaperTemplate>
+void checkBankMatchesOscillators(const T& sampleRate) {
+    //Use an odd number of voices, so the last SIMD register is only partly used
+    static constexpr size_t NumVoices = 37;
+
+    auto bank = std::make_unique<OscillatorBank<T, NumVoices, ShaperTemplate>>();
+    std::vector<Oscillator<T, PhaseAccumulation::Incremental>> oscillators(NumVoices);
+
+    bank->setSampleRate(sampleRate);
+    for (size_t voice = 0; voice < NumVoices; ++voice) {
+        const auto frequency = getBoundedRandom(T{0}, T{20000});
+        bank->setFrequency(voice, frequency);
+
+        oscillators[voice].setWaveform(std::make_unique<ShaperTemplate<T>>());
+        oscillators[voice].setSampleRate(sampleRate);
+        oscillators[voice].setFrequency(frequency);
+    }
+
+    for (size_t i = 0; i < numIterations; ++i) {
+        const auto& frame = bank->perform();
+        for (size_t voice = 0; voice < NumVoices; ++voice) {
+            const Decibel<T> bankLevel = Amplitude{frame[voice]};
+            CHECK_THAT(bankLevel, ResidualDecibels<T>(oscillators[voice].perform(), residualThreshold<T>));
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Perform Oscillator Bank", "[Oscillator Bank]", float, double) {
+    const auto sampleRate = GENERATE(TestType{ 44100.0 }, TestType{ 96000.0 });
+
+    SECTION("Identity") { checkBankMatchesOscillators<TestType, Shaper>(sampleRate); }
+    SECTION("Sin")      { checkBankMatchesOscillators<TestType, SinShaper>(sampleRate); }
+    SECTION("Saw")      { checkBankMatchesOscillators<TestType, SawShaper>(sampleRate); }
+}
+
+TEMPLATE_TEST_CASE("Process Oscillator Bank", "[Oscillator Bank]", float, double) {
+    static constexpr size_t NumVoices = 8;
+    constexpr size_t blockSize = 512;
+    constexpr auto sampleRate = TestType{ 44100 };
+
+    OscillatorBank<TestType, NumVoices, SinShaper> bank{};
+    OscillatorBank<TestType, NumVoices, SinShaper> referenceBank{};
+    bank.setSampleRate(sampleRate);
+    referenceBank.setSampleRate(sampleRate);
+
+    for (size_t voice = 0; voice < NumVoices; ++voice) {
+        const auto frequency = getBoundedRandom(TestType{0}, TestType{20000});
+        const auto phase = getBoundedRandom(TestType{0}, TestType{1});
+        for (auto* b : {&bank, &referenceBank}) {
+            b->setFrequency(voice, frequency);
+            b->setPhase(voice, phase);
+        }
+    }
+
+    std::vector<std::vector<TestType>> buffers(NumVoices, std::vector<TestType>(blockSize));
+    std::vector<TestType*> bufferPointers{};
+    for (auto&& buffer : buffers)
+        bufferPointers.push_back(buffer.data());
+
+    //Processing a block should give the same output as performing the bank one frame at a time
+    bank.process(bufferPointers.data(), blockSize);
+    for (size_t i = 0; i < blockSize; ++i) {
+        const auto& frame = referenceBank.perform();
+        for (size_t voice = 0; voice < NumVoices; ++voice)
+            CHECK(buffers[voice][i] == frame[voice]);
+    }
+}
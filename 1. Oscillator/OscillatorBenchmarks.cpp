@@ -0,0 +1,188 @@
+#include "Oscillator.h"
+#include "StaticOscillator.h"
+#include "OscillatorBank.h"
+#include "SinApproximation.h"
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+//Measures producing a block of a sin wave one sample at a time against filling it with a single process call
+// These are only built into the OscillatorBenchmarks target, run it directly to get the timings
+TEMPLATE_TEST_CASE("Oscillator Block Processing", "[!benchmark][Oscillator]", float, double) {
+    constexpr auto oscillatorFrequency = TestType{ 440 };
+    constexpr auto sampleRate = TestType{ 44100 };
+
+    const auto blockSize = GENERATE(size_t{64}, size_t{512}, size_t{4096});
+    std::vector<TestType> block(blockSize);
+
+    Oscillator<TestType> oscillator{};
+    oscillator.setWaveform(std::make_unique<SinShaper<TestType>>());
+    oscillator.setFrequency(oscillatorFrequency);
+    oscillator.setSampleRate(sampleRate);
+
+    BENCHMARK("Per Sample, " + std::to_string(blockSize) + " Samples") {
+        for (auto&& sample : block)
+            sample = oscillator.perform();
+        return block.back();
+    };
+
+    BENCHMARK("Process, " + std::to_string(blockSize) + " Samples") {
+        oscillator.process(block.data(), block.size());
+        return block.back();
+    };
+}
+
+//Measures the cost of dispatching the shaper through a vtable against compiling it into the loop
+TEMPLATE_TEST_CASE("Static Oscillator Processing", "[!benchmark][Oscillator]", float, double) {
+    constexpr auto oscillatorFrequency = TestType{ 440 };
+    constexpr auto sampleRate = TestType{ 44100 };
+
+    const auto blockSize = GENERATE(size_t{64}, size_t{512}, size_t{4096});
+    std::vector<TestType> block(blockSize);
+
+    Oscillator<TestType> dynamicOscillator{};
+    dynamicOscillator.setWaveform(std::make_unique<SawShaper<TestType>>());
+    dynamicOscillator.setFrequency(oscillatorFrequency);
+    dynamicOscillator.setSampleRate(sampleRate);
+
+    StaticOscillator<TestType, SawShaper> staticOscillator{};
+    staticOscillator.setFrequency(oscillatorFrequency);
+    staticOscillator.setSampleRate(sampleRate);
+
+    BENCHMARK("Dynamic Per Sample, " + std::to_string(blockSize) + " Samples") {
+        for (auto&& sample : block)
+            sample = dynamicOscillator.perform();
+        return block.back();
+    };
+
+    BENCHMARK("Static Per Sample, " + std::to_string(blockSize) + " Samples") {
+        for (auto&& sample : block)
+            sample = staticOscillator.perform();
+        return block.back();
+    };
+
+    BENCHMARK("Static Process, " + std::to_string(blockSize) + " Samples") {
+        staticOscillator.process(block.data(), block.size());
+        return block.back();
+    };
+}
+
+//Measures the index phasor, which wraps with fmod every sample, against the incremental and fixed point phasors
+TEMPLATE_TEST_CASE("Phasor Accumulation", "[!benchmark][Phasor]", float, double) {
+    constexpr auto oscillatorFrequency = TestType{ 440 };
+    constexpr auto sampleRate = TestType{ 44100 };
+
+    const auto blockSize = GENERATE(size_t{64}, size_t{512}, size_t{4096});
+    std::vector<TestType> block(blockSize);
+
+    Phasor<TestType, PhaseAccumulation::Index> indexPhasor{};
+    indexPhasor.setFrequency(oscillatorFrequency);
+    indexPhasor.setSampleRate(sampleRate);
+
+    Phasor<TestType, PhaseAccumulation::Incremental> incrementalPhasor{};
+    incrementalPhasor.setFrequency(oscillatorFrequency);
+    incrementalPhasor.setSampleRate(sampleRate);
+
+    Phasor<TestType, PhaseAccumulation::FixedPoint> fixedPointPhasor{};
+    fixedPointPhasor.setFrequency(oscillatorFrequency);
+    fixedPointPhasor.setSampleRate(sampleRate);
+
+    BENCHMARK("Index, " + std::to_string(blockSize) + " Samples") {
+        indexPhasor.process(block.data(), block.size());
+        return block.back();
+    };
+
+    BENCHMARK("Incremental, " + std::to_string(blockSize) + " Samples") {
+        incrementalPhasor.process(block.data(), block.size());
+        return block.back();
+    };
+
+    BENCHMARK("Fixed Point, " + std::to_string(blockSize) + " Samples") {
+        fixedPointPhasor.process(block.data(), block.size());
+        return block.back();
+    };
+}
+
+//Measures advancing a thousand separate oscillators by one sample against advancing a bank of the same size
+TEMPLATE_TEST_CASE("Oscillator Bank Processing", "[!benchmark][Oscillator Bank]", float, double) {
+    static constexpr size_t NumVoices = 1024;
+    constexpr auto sampleRate = TestType{ 44100 };
+
+    std::vector<Oscillator<TestType, PhaseAccumulation::Incremental>> oscillators(NumVoices);
+    auto bank = std::make_unique<OscillatorBank<TestType, NumVoices, SawShaper>>();
+    std::vector<TestType> frame(NumVoices);
+
+    bank->setSampleRate(sampleRate);
+    for (size_t voice = 0; voice < NumVoices; ++voice) {
+        const auto frequency = TestType(20*(voice+1));
+        oscillators[voice].setWaveform(std::make_unique<SawShaper<TestType>>());
+        oscillators[voice].setSampleRate(sampleRate);
+        oscillators[voice].setFrequency(frequency);
+        bank->setFrequency(voice, frequency);
+    }
+
+    BENCHMARK("Separate Oscillators, " + std::to_string(NumVoices) + " Voices") {
+        for (size_t voice = 0; voice < NumVoices; ++voice)
+            frame[voice] = oscillators[voice].perform();
+        return frame.back();
+    };
+
+    BENCHMARK("Oscillator Bank, " + std::to_string(NumVoices) + " Voices") {
+        return bank->perform().back();
+    };
+}
+
+//Measures modulating the frequency every sample with setFrequency against passing the frequencies to process
+TEMPLATE_TEST_CASE("Phasor Frequency Modulation", "[!benchmark][Phasor]", float, double) {
+    constexpr auto sampleRate = TestType{ 44100 };
+
+    const auto blockSize = GENERATE(size_t{64}, size_t{512}, size_t{4096});
+    std::vector<TestType> frequencies(blockSize), block(blockSize);
+    for (size_t i = 0; i < blockSize; ++i)
+        frequencies[i] = TestType{440}+TestType{100}*std::sin(static_cast<TestType>(i)*TestType{.01});
+
+    Phasor<TestType, PhaseAccumulation::Incremental> phasor{};
+    phasor.setSampleRate(sampleRate);
+
+    BENCHMARK("Set Frequency Per Sample, " + std::to_string(blockSize) + " Samples") {
+        for (size_t i = 0; i < blockSize; ++i) {
+            phasor.setFrequency(frequencies[i]);
+            block[i] = phasor.perform();
+        }
+        return block.back();
+    };
+
+    BENCHMARK("Process Frequencies, " + std::to_string(blockSize) + " Samples") {
+        phasor.process(frequencies.data(), block.data(), blockSize);
+        return block.back();
+    };
+
+    BENCHMARK("Ramp, " + std::to_string(blockSize) + " Samples") {
+        phasor.setTargetFrequency(frequencies.back(), blockSize);
+        phasor.process(block.data(), blockSize);
+        return block.back();
+    };
+}
+
+//Measures shaping a block of phases with std::sin against each of the polynomial accuracy tiers
+TEMPLATE_TEST_CASE("Sin Approximation", "[!benchmark][Oscillator]", float, double) {
+    constexpr size_t blockSize = 4096;
+
+    std::vector<TestType> phases(blockSize), block(blockSize);
+    for (size_t i = 0; i < blockSize; ++i)
+        phases[i] = std::fmod(static_cast<TestType>(i)*TestType{.01}, TestType{1});
+
+    const auto benchmarkShaper = [&](const std::string& name, auto shaper) {
+        BENCHMARK(name + ", " + std::to_string(blockSize) + " Samples") {
+            std::copy(phases.begin(), phases.end(), block.begin());
+            shaper.process(block.data(), block.size());
+            return block.back();
+        };
+    };
+
+    benchmarkShaper("std::sin", SinShaper<TestType>{});
+    benchmarkShaper("-120dB", SinShaper120dB<TestType>{});
+    benchmarkShaper("-96dB", SinShaper96dB<TestType>{});
+    benchmarkShaper("-60dB", SinShaper60dB<TestType>{});
+}
@@ -1,4 +1,5 @@
 #include "Oscillator.h"
+#include "PolyBlepShaper.h"
 
 #include <catch2/catch.hpp>
 
@@ -94,12 +95,173 @@ TEMPLATE_TEST_CASE("Perform Oscillator", "[Oscillator]", float, double) {
             if(i%mod) {
                 const auto rand = getBoundedRandom(TestType{0}, TestType{1});
                 const auto output = oscillator.perform(rand);
+                //The bounds are inclusive, so the phase can be exactly 1, which wraps to 0
+                const auto expected = rand < TestType{1} ? rand : TestType{0};
                 CHECK_THAT(output,
-                             Catch::WithinRel(rand));
+                             Catch::WithinRel(expected));
             }
                 //Otherwise, just perform the oscillator
             else
                 oscillator.perform();
         }
     }
-}
\ No newline at end of file
+}
+
+TEMPLATE_TEST_CASE("Oscillator Frequency Modulation", "[Oscillator]", float, double) {
+    constexpr auto oscillatorFrequency = TestType{ 440 };
+    constexpr auto sampleRate = TestType{ 44100 };
+    constexpr size_t blockSize = 512;
+
+    Oscillator<TestType, PhaseAccumulation::Incremental> oscillator{};
+    oscillator.setWaveform(std::make_unique<SinShaper<TestType>>());
+    oscillator.setFrequency(oscillatorFrequency);
+    oscillator.setSampleRate(sampleRate);
+
+    Phasor<TestType, PhaseAccumulation::Incremental> phasor{};
+    phasor.setFrequency(oscillatorFrequency);
+    phasor.setSampleRate(sampleRate);
+
+    //Vibrato of a few semitones at 5Hz
+    std::vector<TestType> block(blockSize), reference(blockSize);
+    for (size_t i = 0; i < blockSize; ++i)
+        block[i] = oscillatorFrequency*(TestType{1}+TestType{.2}*std::sin(juce::MathConstants<TestType>::twoPi*TestType{5}*static_cast<TestType>(i)/sampleRate));
+
+    //The frequencies can be modulated in place
+    phasor.process(block.data(), reference.data(), blockSize);
+    oscillator.process(block.data(), block.data(), blockSize);
+
+    for (size_t i = 0; i < blockSize; ++i)
+        CHECK_THAT(block[i], Catch::WithinAbs(SinShaper<TestType>{}.perform(reference[i]), 1e-6));
+}
+
+//Under frequency modulation, each PolyBLEP correction has to be as wide as the phase moved on that sample,
+// not the fastest it moved anywhere in the block
+TEMPLATE_TEST_CASE("Oscillator Frequency Modulation PolyBLEP Velocity", "[Oscillator]", float, double) {
+    constexpr auto sampleRate = TestType{ 44100 };
+    constexpr size_t blockSize = 300;
+
+    Oscillator<TestType, PhaseAccumulation::Incremental> oscillator{};
+    oscillator.setWaveform(std::make_unique<PolyBlepSawShaper<TestType>>());
+    oscillator.setSampleRate(sampleRate);
+
+    Phasor<TestType, PhaseAccumulation::Incremental> phasor{};
+    phasor.setSampleRate(sampleRate);
+
+    //A sweep from 100Hz up to 8kHz, and a negative frequency, so the fastest velocity is far from most samples'
+    std::vector<TestType> frequencies(blockSize), block(blockSize), phases(blockSize);
+    for (size_t i = 0; i < blockSize; ++i)
+        frequencies[i] = TestType{100}+TestType{7900}*static_cast<TestType>(i)/static_cast<TestType>(blockSize);
+    frequencies[blockSize/2] = TestType{-12000};
+
+    phasor.process(frequencies.data(), phases.data(), blockSize);
+    oscillator.process(frequencies.data(), block.data(), blockSize);
+
+    PolyBlepSawShaper<TestType> shaper{};
+    for (size_t i = 0; i < blockSize; ++i) {
+        shaper.setPhaseVelocity(std::abs(frequencies[i])/sampleRate);
+        CHECK_THAT(block[i], Catch::WithinAbs(shaper.perform(phases[i]), 1e-5));
+    }
+}
+
+//A shaper that keeps every phase velocity it's given, so tests can see what the oscillator told it
+template<typename SampleType>
+class VelocityRecordingShaper : public Shaper<SampleType>
+{
+public:
+    explicit VelocityRecordingShaper(std::vector<SampleType>& newVelocities) : velocities(newVelocities) {}
+
+    virtual void setPhaseVelocity(const SampleType& newPhaseVelocity) override {
+        velocities.push_back(newPhaseVelocity);
+    }
+
+private:
+    std::vector<SampleType>& velocities;
+};
+
+//While the frequency ramps down, the shaper has to be given the velocity from the start of what it shapes,
+// or band-limited shapers would alias at the start of it
+TEMPLATE_TEST_CASE("Oscillator Ramp Shaper Velocity", "[Oscillator]", float, double) {
+    constexpr auto sampleRate = TestType{ 44100 };
+    constexpr auto startFrequency = TestType{ 10000 }, endFrequency = TestType{ 100 };
+    constexpr size_t rampLength = 1024, blockSize = 64;
+    const auto renderBlocks = GENERATE(false, true);
+
+    std::vector<TestType> velocities{};
+    Oscillator<TestType> oscillator{};
+    oscillator.setWaveform(std::make_unique<VelocityRecordingShaper<TestType>>(velocities));
+    oscillator.setSampleRate(sampleRate);
+    oscillator.setFrequency(startFrequency);
+    oscillator.setTargetFrequency(endFrequency, rampLength);
+
+    std::vector<TestType> block(blockSize);
+    for (size_t i = 0; i < rampLength; i += blockSize) {
+        const auto startVelocity = startFrequency/sampleRate
+                                   +(endFrequency-startFrequency)/sampleRate*static_cast<TestType>(i)/static_cast<TestType>(rampLength);
+        velocities.clear();
+
+        if (renderBlocks)
+            oscillator.process(block.data(), blockSize);
+        else
+            for (auto& sample : block)
+                sample = oscillator.perform();
+
+        //The velocity the shaper shapes with, given first, is the fastest in the block, which is the one at the start
+        REQUIRE(!velocities.empty());
+        CHECK_THAT(velocities.front(), Catch::WithinRel(startVelocity, TestType{ 1e-3 }));
+    }
+
+    //Once the ramp is over, the shaper is left at the end frequency
+    CHECK_THAT(velocities.back(), Catch::WithinRel(endFrequency/sampleRate, TestType{ 1e-3 }));
+}
+
+TEMPLATE_TEST_CASE("Oscillator Sub-Sample Sync", "[Oscillator]", float, double) {
+    constexpr auto sampleRate = TestType{ 44100 };
+    //Put the master on a whole number of cycles, so the synced signal is periodic for measureAliasing
+    constexpr size_t fundamentalBin = 211;
+    constexpr size_t numSamples = 4096;
+    constexpr auto masterFrequency = static_cast<TestType>(fundamentalBin)*sampleRate/static_cast<TestType>(numSamples);
+    //The slave is slower than the master, so all of its jumps come from the sync
+    // A synced sin jumps by a different amount depending on the ratio, which checks the jumps are measured properly
+    const auto slaveFrequency = GENERATE(TestType{ .3 }, TestType{ .55 }, TestType{ .8 })*masterFrequency;
+
+    Phasor<TestType, PhaseAccumulation::Incremental> master{};
+    master.setSampleRate(sampleRate);
+    master.setFrequency(masterFrequency);
+
+    std::vector<TestType> masterOutput(numSamples);
+    std::vector<SyncEvent<TestType>> events(numSamples);
+    const auto numEvents = master.processWithWraps(masterOutput.data(), numSamples, events.data(), events.size());
+
+    const auto renderSlave = [&](bool smoothJumps) {
+        Oscillator<TestType, PhaseAccumulation::Incremental> slave{};
+        slave.setWaveform(std::make_unique<SinShaper<TestType>>());
+        slave.setSampleRate(sampleRate);
+        slave.setFrequency(slaveFrequency);
+
+        std::vector<TestType> output(numSamples);
+        slave.processSynced(output.data(), numSamples, events.data(), numEvents, smoothJumps);
+        return output;
+    };
+
+    SECTION("Without smoothing, the output is the shaped synced phase") {
+        Phasor<TestType, PhaseAccumulation::Incremental> slavePhasor{};
+        slavePhasor.setSampleRate(sampleRate);
+        slavePhasor.setFrequency(slaveFrequency);
+
+        std::vector<TestType> reference(numSamples);
+        slavePhasor.processSynced(reference.data(), numSamples, events.data(), numEvents);
+        SinShaper<TestType>{}.process(reference.data(), numSamples);
+
+        const auto output = renderSlave(false);
+        for (size_t i = 0; i < numSamples; ++i)
+            CHECK(output[i] == reference[i]);
+    }
+
+    SECTION("Smoothing the jumps reduces aliasing") {
+        const Decibel<TestType> hardAliasing = Amplitude{measureAliasing(renderSlave(false), fundamentalBin)};
+        const Decibel<TestType> smoothAliasing = Amplitude{measureAliasing(renderSlave(true), fundamentalBin)};
+
+        INFO("Hard sync aliasing: " << hardAliasing << ", smoothed aliasing: " << smoothAliasing);
+        CHECK(smoothAliasing.count() < hardAliasing.count()-TestType{10});
+    }
+}
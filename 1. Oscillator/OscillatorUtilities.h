@@ -2,6 +2,9 @@
 
 #include <catch2/catch.hpp>
 
+#include <complex>
+#include <vector>
+
 template<typename T>
 const auto getSmallestAccurateValue() {
     if constexpr (std::is_integral_v<T>)
@@ -28,4 +31,42 @@ auto closeToEdge(const std::pair<T, T>& ins, const T& lowerBound, const T& upper
 //    const auto nextToLower1 = Catch::WithinAbs(lowerBound, .000001).match(ins.second);
 //    const auto nextToUpper1 = Catch::WithinAbs(upperBound, .000001).match(ins.first);
 //    return (nextToLower && nextToUpper) || (nextToLower1 && nextToUpper1);
+}
+
+//Gets the distance between two phases, treating 0 and 1 as the same point
+template<typename T>
+auto getPhaseDistance(const T& phase1, const T& phase2) noexcept {
+    const auto distance = std::abs(phase1-phase2);
+    return std::min(distance, T{1}-distance);
+}
+
+//Measures how much of a periodic signal's energy is aliasing
+// The signal should hold exactly fundamentalBin cycles over its length, so its harmonics land exactly on multiples of that bin.
+// If the signal's length isn't a multiple of fundamentalBin, any harmonic that folds back over nyquist
+// lands between the harmonics, so all of the energy in the other bins is counted as aliasing.
+//Returns the ratio of the aliased amplitude to the total amplitude
+template<typename T>
+auto measureAliasing(const std::vector<T>& signal, size_t fundamentalBin) {
+    const auto size = signal.size();
+
+    //Use a table of twiddle factors, since a plain DFT is fine for the sizes we test with
+    std::vector<std::complex<double>> twiddles(size);
+    for (size_t i = 0; i < size; ++i)
+        twiddles[i] = std::polar(1.0, -2.0*3.14159265358979323846*static_cast<double>(i)/static_cast<double>(size));
+
+    double harmonicEnergy = 0.0, aliasedEnergy = 0.0;
+    //Skip DC, since it's neither a harmonic nor aliasing
+    for (size_t bin = 1; bin < size/2; ++bin) {
+        std::complex<double> sum{};
+        for (size_t i = 0; i < size; ++i)
+            sum += static_cast<double>(signal[i])*twiddles[(bin*i)%size];
+
+        const auto energy = std::norm(sum);
+        if (bin%fundamentalBin == 0)
+            harmonicEnergy += energy;
+        else
+            aliasedEnergy += energy;
+    }
+
+    return static_cast<T>(std::sqrt(aliasedEnergy/(harmonicEnergy+aliasedEnergy)));
 }
\ No newline at end of file
@@ -1,32 +1,109 @@
 #pragma once
 
-//Include fmod and size_t
+//Include fmod, floor and size_t
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+
+// Tagged value for choosing how a phasor keeps track of its phase
+// Index counts samples, and derives the phase from the count with fmod every sample
+// Incremental adds the phase increment to a double precision accumulator every sample,
+// and wraps it by subtracting 1 when it passes 1. This is much cheaper than the fmods,
+// and the accumulator doesn't lose precision the way a float sample count does after 2^24 samples
+// FixedPoint keeps the phase as a 64 bit unsigned integer, where a whole cycle is 2^64
+// Adding the phase increment wraps for free when the integer overflows, so there's no rounding error to build up,
+// and the output is the top bits of the phase, scaled down to 0-1
+// i.e. Phasor<float, PhaseAccumulation::Incremental>
+enum PhaseAccumulation {
+    Index, Incremental, FixedPoint
+};
+
+//A point between two samples where a master phasor started a new cycle, for syncing other phasors to it
+// sampleIndex is the first sample of the new cycle,
+// and fraction is how long before that sample the cycle started, as a fraction of a sample between 0 and 1
+template<typename SampleType>
+struct SyncEvent
+{
+    size_t sampleIndex;
+    SampleType fraction;
+};
 
 // A phasor class for driving an oscillator.
 // This outputs a signal from 0-1 periodically according to a frequency and sample rate.
-template<typename SampleType>
+template<typename SampleType, PhaseAccumulation Accumulation = PhaseAccumulation::Index>
 class Phasor
 {
 public:
     void setSampleRate(SampleType newPerformRate) noexcept {
         sampleRate = newPerformRate;
+        reciprocalSampleRate = 1.0/static_cast<double>(sampleRate);
+        stopRamp();
         updatePhase();
     }
 
     void reset() noexcept {
+        //A ramp that was running jumps to its target, rather than carrying on gliding from the new phase
+        if (rampSamplesRemaining > 0) {
+            rampSamplesRemaining = 0;
+            frequency = targetFrequency;
+            updatePhase();
+        }
+
         counter = 0;
         phase = SampleType{0};
+        accumulator = 0.0;
+        fixedPhase = 0;
+
+        //The phases from before the reset aren't where the next block carries on from
+        wrapLastPhase = -1.0;
+        wrapNextPhase = -1.0;
     }
 
     void setFrequency(const SampleType& newFrequency) noexcept {
+        stopRamp();
         frequency = newFrequency;
         updatePhase();
     }
 
+    //Glide from the current frequency to a new one over numSamples
+    // Like juce::SmoothedValue, the phase increment moves linearly towards its target,
+    // so the ramp costs an add per sample instead of a call to setFrequency every sample
+    //A new target during a ramp starts gliding from wherever the ramp has got to
+    //Calling setFrequency, setSampleRate or reset during a ramp ends it early
+    void setTargetFrequency(const SampleType& newFrequency, size_t numSamples) noexcept {
+        if (numSamples == 0) {
+            setFrequency(newFrequency);
+            return;
+        }
+
+        if (rampSamplesRemaining == 0) {
+            accumulator = getCurrentPhase();
+            rampVelocity = static_cast<double>(frequency)*reciprocalSampleRate;
+        }
+        rampStep = (static_cast<double>(newFrequency)*reciprocalSampleRate-rampVelocity)/static_cast<double>(numSamples);
+        targetFrequency = newFrequency;
+        rampSamplesRemaining = numSamples;
+    }
+
+    bool isRamping() const noexcept { return rampSamplesRemaining > 0; }
+
     void setPhase(const SampleType& newPhase) noexcept {
-        phase = std::fmod(newPhase, SampleType{1});
-        counter = 0;
+        if constexpr (Accumulation == PhaseAccumulation::Incremental) {
+            accumulator = std::fmod(static_cast<double>(newPhase), 1.0);
+            if (accumulator < 0.0)
+                accumulator += 1.0;
+        }
+        else if constexpr (Accumulation == PhaseAccumulation::FixedPoint) {
+            fixedPhase = toFixedPoint(static_cast<double>(newPhase));
+            accumulator = fromFixedPoint<double>(fixedPhase);
+        }
+        else {
+            phase = std::fmod(newPhase, SampleType{1});
+            counter = 0;
+            //A ramp keeps its phase in the accumulator, so keep that in step too
+            accumulator = static_cast<double>(phase < SampleType{0} ? phase+SampleType{1} : phase);
+        }
     }
 
     //Set the phase, and then increment the phase value, and then wrap it between 0 and 1
@@ -37,16 +114,232 @@ public:
 
     //Gets the current value of the phasor, plus any phase offsets
     SampleType perform() noexcept {
-        return std::fmod(phase+getPhaseFromIndex(counter++), SampleType{1});
+        if (rampSamplesRemaining > 0)
+            return performRamp();
+
+        return performSteady();
+    }
+
+    //Gets the phase the next call to perform will output
+    SampleType getPhase() const noexcept {
+        return narrowPhase(getCurrentPhase());
+    }
+
+    //Gets how far the phase moves each sample
+    SampleType getPhaseVelocity() const noexcept {
+        if (rampSamplesRemaining > 0)
+            return static_cast<SampleType>(rampVelocity);
+        else if constexpr (Accumulation == PhaseAccumulation::Incremental)
+            return static_cast<SampleType>(incrementalVelocity);
+        else if constexpr (Accumulation == PhaseAccumulation::FixedPoint)
+            return fromFixedPoint<SampleType>(fixedVelocity);
+        else
+            return phaseVelocity;
+    }
+
+    //Gets how far the phase would move each sample at a frequency, without changing the phasor
+    SampleType getPhaseVelocity(const SampleType& atFrequency) const noexcept {
+        return static_cast<SampleType>(static_cast<double>(atFrequency)*reciprocalSampleRate);
+    }
+
+    //Write the next numSamples values of the phasor into output
+    void process(SampleType* output, size_t numSamples) noexcept {
+        size_t i = 0;
+        for (; i < numSamples && rampSamplesRemaining > 0; ++i)
+            output[i] = performRamp();
+        for (; i < numSamples; ++i)
+            output[i] = performSteady();
+    }
+
+    //Write the next numSamples values of the phasor into output, with a separate frequency for every sample
+    // This is for audio rate frequency modulation. Each frequency becomes a phase increment with a single multiply
+    // by the reciprocal of the sample rate, rather than the divisions and fmods in setFrequency
+    //The frequency set with setFrequency isn't changed, so the phasor carries on at that frequency afterwards
+    //frequencies and output can be the same buffer
+    void process(const SampleType* frequencies, SampleType* output, size_t numSamples) noexcept {
+        stopRamp();
+
+        auto current = getCurrentPhase();
+        for (size_t i = 0; i < numSamples; ++i) {
+            const auto velocity = static_cast<double>(frequencies[i])*reciprocalSampleRate;
+            output[i] = narrowPhase(current);
+            //Modulated frequencies can be negative or above nyquist, so wrap with floor rather than a single subtraction
+            current += velocity;
+            current -= std::floor(current);
+        }
+        setCurrentPhase(current);
+    }
+
+    //Write the next numSamples values of the phasor into output, and write an event into events each time it starts a new cycle,
+    // up to maxEvents. This returns the number of events written
+    //A new cycle is a phase lower than the one before it, and the distance between the two, wrapped round,
+    // is how far the phase moved over that sample, even while the frequency ramps, so the wrap's fraction comes from that
+    //The last phase of each block is kept, so a cycle that starts on the first sample of the next block is found too.
+    // If anything else moves the phase in between, like setPhase or perform, the first sample of the next block can't start a cycle
+    size_t processWithWraps(SampleType* output, size_t numSamples, SyncEvent<SampleType>* events, size_t maxEvents) noexcept {
+        //A phase below 0 never counts as going down, so with no phase before the block the first sample isn't a new cycle
+        auto previous = getCurrentPhase() == wrapNextPhase ? wrapLastPhase : -1.0;
+        process(output, numSamples);
+
+        size_t numEvents = 0;
+        for (size_t i = 0; i < numSamples; ++i) {
+            const auto current = static_cast<double>(output[i]);
+            if (current < previous && numEvents < maxEvents)
+                events[numEvents++] = {i, static_cast<SampleType>(current/(current+1.0-previous))};
+            previous = current;
+        }
+
+        if (numSamples > 0) {
+            wrapLastPhase = previous;
+            wrapNextPhase = getCurrentPhase();
+        }
+        return numEvents;
+    }
+
+    //Write the next numSamples values of the phasor into output, hard synced to a master phasor's events
+    // The phasor runs as a block between events. At each event, it's reset to the phase it would have reached
+    // if it had been set to syncPhase at the exact moment the master started its cycle, rather than at the next sample
+    //The events need to be in order, with sample indices inside the block
+    // An event before the one ahead of it is clamped to that one's sample, and an event past the end of the block to the end,
+    // so the phasor never writes outside of output
+    void processSynced(SampleType* output, size_t numSamples, const SyncEvent<SampleType>* events, size_t numEvents,
+                       const SampleType& syncPhase = SampleType{0}) noexcept {
+        size_t start = 0;
+        for (size_t i = 0; i < numEvents; ++i) {
+            const auto sampleIndex = std::clamp(events[i].sampleIndex, start, numSamples);
+            process(output+start, sampleIndex-start);
+            start = sampleIndex;
+
+            auto newPhase = static_cast<double>(syncPhase)
+                            +static_cast<double>(events[i].fraction)*static_cast<double>(getPhaseVelocity());
+            newPhase -= std::floor(newPhase);
+            //This can only be 1 if the sync phase was a tiny negative number
+            setCurrentPhase(newPhase < 1.0 ? newPhase : 0.0);
+        }
+        process(output+start, numSamples-start);
     }
 
 private:
     SampleType phase{0}, frequency{0}, sampleRate{44100},
             phaseVelocity{0};
+    double reciprocalSampleRate{1.0/44100.0};
 
     size_t counter {0};
     SampleType iterationsPerCycle{0};
 
+    //The state for incremental accumulation
+    // This is always double precision, so float phasors don't drift over long runs
+    //Ramps and frequency modulation accumulate the phase here too, whichever strategy is used
+    double accumulator{0.0}, incrementalVelocity{0.0};
+
+    //The state for fixed point accumulation
+    uint64_t fixedPhase{0}, fixedVelocity{0};
+
+    //The last phase processWithWraps wrote, and the phase it left the phasor at, for finding a new cycle at the start of the next block
+    double wrapLastPhase{-1.0}, wrapNextPhase{-1.0};
+
+    //The state for a frequency ramp
+    double rampVelocity{0.0}, rampStep{0.0};
+    SampleType targetFrequency{0};
+    size_t rampSamplesRemaining{0};
+
+    SampleType performSteady() noexcept {
+        if constexpr (Accumulation == PhaseAccumulation::Incremental) {
+            const auto output = narrowPhase(accumulator);
+
+            accumulator += incrementalVelocity;
+            if (accumulator >= 1.0)
+                accumulator -= 1.0;
+
+            return output;
+        }
+        else if constexpr (Accumulation == PhaseAccumulation::FixedPoint) {
+            const auto output = fromFixedPoint<SampleType>(fixedPhase);
+            fixedPhase += fixedVelocity;
+            return output;
+        }
+        else {
+            return std::fmod(phase+getPhaseFromIndex(counter++), SampleType{1});
+        }
+    }
+
+    SampleType performRamp() noexcept {
+        const auto output = narrowPhase(accumulator);
+
+        rampVelocity += rampStep;
+        accumulator += rampVelocity;
+        accumulator -= std::floor(accumulator);
+
+        if (--rampSamplesRemaining == 0)
+            finishRamp();
+
+        return output;
+    }
+
+    //Finish any ramp that's running early
+    void stopRamp() noexcept {
+        if (rampSamplesRemaining > 0)
+            finishRamp();
+    }
+
+    //Carry on from the ramp's phase at its target frequency
+    void finishRamp() noexcept {
+        rampSamplesRemaining = 0;
+        setCurrentPhase(accumulator);
+        frequency = targetFrequency;
+        updatePhase();
+    }
+
+    //Gets the phase the next call to perform will output, in double precision
+    double getCurrentPhase() const noexcept {
+        if constexpr (Accumulation == PhaseAccumulation::Incremental)
+            return accumulator;
+        else if (rampSamplesRemaining > 0)
+            return accumulator;
+        else if constexpr (Accumulation == PhaseAccumulation::FixedPoint)
+            return fromFixedPoint<double>(fixedPhase);
+        else {
+            const auto current = static_cast<double>(std::fmod(phase+getPhaseFromIndex(counter), SampleType{1}));
+            return current < 0.0 ? current+1.0 : current;
+        }
+    }
+
+    //Sets the phase the next call to perform will output, from a phase between 0 and 1
+    void setCurrentPhase(double newPhase) noexcept {
+        accumulator = newPhase;
+        if constexpr (Accumulation == PhaseAccumulation::Index) {
+            phase = narrowPhase(newPhase);
+            counter = 0;
+        }
+        else if constexpr (Accumulation == PhaseAccumulation::FixedPoint)
+            fixedPhase = toFixedPoint(newPhase);
+    }
+
+    //A phase just below 1 can round up to 1 when it's narrowed to a float, so wrap it in that case
+    static SampleType narrowPhase(double newPhase) noexcept {
+        const auto narrowed = static_cast<SampleType>(newPhase);
+        if constexpr (sizeof(SampleType) < sizeof(double))
+            return narrowed < SampleType{1} ? narrowed : SampleType{0};
+        else
+            return narrowed;
+    }
+
+    //Converts a phase to a fraction of 2^64, wrapping it between 0 and 1 first
+    // 2^64 is exactly representable as a double, and the wrapped phase is always less than 1, so this can't overflow
+    static uint64_t toFixedPoint(double newPhase) noexcept {
+        newPhase -= std::floor(newPhase);
+        //A tiny negative phase can round up to 1 when it's wrapped
+        return newPhase < 1.0 ? static_cast<uint64_t>(newPhase*18446744073709551616.0) : 0;
+    }
+
+    //Takes as many of the top bits as the output type can hold exactly, so the output never rounds up to 1
+    template<typename OutputType>
+    static OutputType fromFixedPoint(uint64_t newPhase) noexcept {
+        constexpr auto digits = std::numeric_limits<OutputType>::digits;
+        constexpr auto scale = OutputType{1}/static_cast<OutputType>(uint64_t{1} << digits);
+        return static_cast<OutputType>(newPhase >> (64-digits))*scale;
+    }
+
     //Get the phase increment value by multiplying the number of iterations by the phase velocity
     // The phase increment is bounded by the number of iterations per cycle
     // For example, if it takes 10 increment to go one waveform, and the index is 99
@@ -57,9 +350,22 @@ private:
     }
 
     void updatePhase() {
-        phaseVelocity = frequency/sampleRate;
-        iterationsPerCycle = SampleType{1}/phaseVelocity;
-        phase = std::fmod(static_cast<SampleType>(phase+getPhaseFromIndex(counter)), SampleType{1});
+        if constexpr (Accumulation == PhaseAccumulation::Incremental) {
+            //Use the same increment as the index strategy would, so both strategies play the same frequency
+            //Keep it between 0 and 1, so a single subtraction is always enough to wrap the accumulator
+            incrementalVelocity = std::fmod(static_cast<double>(frequency/sampleRate), 1.0);
+            if (incrementalVelocity < 0.0)
+                incrementalVelocity += 1.0;
+        }
+        else if constexpr (Accumulation == PhaseAccumulation::FixedPoint) {
+            //Use the same increment as the index strategy would, so every strategy plays the same frequency
+            fixedVelocity = toFixedPoint(static_cast<double>(frequency/sampleRate));
+        }
+        else {
+            phaseVelocity = frequency/sampleRate;
+            iterationsPerCycle = SampleType{1}/phaseVelocity;
+            phase = std::fmod(static_cast<SampleType>(phase+getPhaseFromIndex(counter)), SampleType{1});
+        }
     }
 
 
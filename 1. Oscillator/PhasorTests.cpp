@@ -7,12 +7,17 @@
 #include "../Utilities/DecibelMatchers.h"
 #include "../Utilities/Random.h"
 
+#include <array>
+
 //TODO: add edge check to all phasor tests
-TEMPLATE_TEST_CASE("Perform Phasor", "[Phasor]", float, double) {
+TEMPLATE_TEST_CASE_SIG("Perform Phasor", "[Phasor]", ((typename TestType, PhaseAccumulation Accumulation), TestType, Accumulation),
+                            (float, PhaseAccumulation::Index), (double, PhaseAccumulation::Index),
+                            (float, PhaseAccumulation::Incremental), (double, PhaseAccumulation::Incremental),
+                            (float, PhaseAccumulation::FixedPoint), (double, PhaseAccumulation::FixedPoint)) {
     constexpr auto oscillatorFrequency = TestType{ 440 };
     constexpr auto sampleRate = TestType{ 44100 };
 
-    Phasor<TestType> phasor{};
+    Phasor<TestType, Accumulation> phasor{};
     phasor.setFrequency(oscillatorFrequency);
     phasor.setSampleRate(sampleRate);
 
@@ -29,11 +34,14 @@ TEMPLATE_TEST_CASE("Perform Phasor", "[Phasor]", float, double) {
     }
 }
 
-TEMPLATE_TEST_CASE("Perform Phasor With Different Sample Rates", "[Phasor]", float, double) {
+TEMPLATE_TEST_CASE_SIG("Perform Phasor With Different Sample Rates", "[Phasor]", ((typename TestType, PhaseAccumulation Accumulation), TestType, Accumulation),
+                            (float, PhaseAccumulation::Index), (double, PhaseAccumulation::Index),
+                            (float, PhaseAccumulation::Incremental), (double, PhaseAccumulation::Incremental),
+                            (float, PhaseAccumulation::FixedPoint), (double, PhaseAccumulation::FixedPoint)) {
     const auto sampleRate = GENERATE(TestType{ 44100.0 }, TestType{ 48000.0 }, TestType{ 88200.0 }, TestType{ 96000.0 }, TestType{ 176400.0 }, TestType{ 192000.0 });
     constexpr auto oscillatorFrequency = TestType{ 440 };
 
-    Phasor<TestType> phasor{};
+    Phasor<TestType, Accumulation> phasor{};
     phasor.setFrequency(oscillatorFrequency);
     phasor.setSampleRate(sampleRate);
 
@@ -51,11 +59,14 @@ TEMPLATE_TEST_CASE("Perform Phasor With Different Sample Rates", "[Phasor]", flo
     }
 }
 
-TEMPLATE_TEST_CASE("Perform Phasor With Random Frequencies", "[Phasor]", float, double) {
+TEMPLATE_TEST_CASE_SIG("Perform Phasor With Random Frequencies", "[Phasor]", ((typename TestType, PhaseAccumulation Accumulation), TestType, Accumulation),
+                            (float, PhaseAccumulation::Index), (double, PhaseAccumulation::Index),
+                            (float, PhaseAccumulation::Incremental), (double, PhaseAccumulation::Incremental),
+                            (float, PhaseAccumulation::FixedPoint), (double, PhaseAccumulation::FixedPoint)) {
     const auto oscillatorFrequency = GENERATE(take(100, random(TestType{ 0 }, TestType{ 20000 })));
     constexpr auto sampleRate = TestType{ 44100 };
 
-    Phasor<TestType> phasor{};
+    Phasor<TestType, Accumulation> phasor{};
     phasor.setFrequency(oscillatorFrequency);
     phasor.setSampleRate(sampleRate);
 
@@ -73,11 +84,14 @@ TEMPLATE_TEST_CASE("Perform Phasor With Random Frequencies", "[Phasor]", float,
     }
 }
 
-TEMPLATE_TEST_CASE("Phasor Sync", "[Phasor]", float, double) {
+TEMPLATE_TEST_CASE_SIG("Phasor Sync", "[Phasor]", ((typename TestType, PhaseAccumulation Accumulation), TestType, Accumulation),
+                            (float, PhaseAccumulation::Index), (double, PhaseAccumulation::Index),
+                            (float, PhaseAccumulation::Incremental), (double, PhaseAccumulation::Incremental),
+                            (float, PhaseAccumulation::FixedPoint), (double, PhaseAccumulation::FixedPoint)) {
     const auto oscillatorFrequency = GENERATE(take(100, random(TestType{ 5 }, TestType{ 20000 })));
     constexpr auto sampleRate = TestType{ 44100 };
 
-    Phasor<TestType> phasor{};
+    Phasor<TestType, Accumulation> phasor{};
     phasor.setFrequency(oscillatorFrequency);
     phasor.setSampleRate(sampleRate);
 
@@ -95,4 +109,365 @@ TEMPLATE_TEST_CASE("Phasor Sync", "[Phasor]", float, double) {
         else
             phasor.perform();
     }
-}
\ No newline at end of file
+}
+
+//Checks that an accumulating phasor stays within the residual threshold of an exact phase over a run
+template<typename T, PhaseAccumulation Accumulation>
+void checkPhasorDrift(const T& oscillatorFrequency, const T& sampleRate, size_t numSamples) {
+    Phasor<T, Accumulation> phasor{};
+    phasor.setFrequency(oscillatorFrequency);
+    phasor.setSampleRate(sampleRate);
+
+    //Work out the reference phase with extended precision from the sample index, so it can't drift itself
+    const auto phaseIncrement = static_cast<long double>(oscillatorFrequency/sampleRate);
+    const auto maximumError = Amplitude<T>{residualThreshold<T>}.count();
+
+    T largestError{0};
+    for (size_t i = 0; i < numSamples; ++i) {
+        const auto phasorReference = static_cast<T>(std::fmod(static_cast<long double>(i)*phaseIncrement, 1.0L));
+        largestError = std::max(largestError, getPhaseDistance(phasor.perform(), phasorReference));
+    }
+
+    CHECK(largestError < maximumError);
+}
+
+TEMPLATE_TEST_CASE_SIG("Accumulating Phasor Drift", "[Phasor]", ((typename TestType, PhaseAccumulation Accumulation), TestType, Accumulation),
+                            (float, PhaseAccumulation::Incremental), (double, PhaseAccumulation::Incremental),
+                            (float, PhaseAccumulation::FixedPoint), (double, PhaseAccumulation::FixedPoint)) {
+    const auto oscillatorFrequency = GENERATE(take(10, random(TestType{ 0 }, TestType{ 20000 })));
+    const auto sampleRate = GENERATE(TestType{ 44100.0 }, TestType{ 48000.0 }, TestType{ 96000.0 }, TestType{ 192000.0 });
+
+    checkPhasorDrift<TestType, Accumulation>(oscillatorFrequency, sampleRate, numIterations);
+}
+
+//A float sample counter can't count past 2^24 exactly, which is only around 6 minutes at 44.1kHz
+//Check that the accumulating phasors are still accurate after around 25 minutes of rendering
+TEST_CASE("Accumulating Phasor Long Run", "[Phasor]") {
+    const auto oscillatorFrequency = GENERATE(take(2, random(0.0f, 20000.0f)));
+
+    SECTION("Incremental") {
+        checkPhasorDrift<float, PhaseAccumulation::Incremental>(oscillatorFrequency, 44100.0f, size_t{1} << 26);
+    }
+    SECTION("Fixed Point") {
+        checkPhasorDrift<float, PhaseAccumulation::FixedPoint>(oscillatorFrequency, 44100.0f, size_t{1} << 26);
+    }
+}
+
+//A fixed point phasor whose phase increment is an exact binary fraction comes back to exactly the same phase
+TEMPLATE_TEST_CASE("Fixed Point Phasor Has No Drift", "[Phasor]", float, double) {
+    //This is a phase increment of 1/64
+    constexpr auto sampleRate = TestType{ 65536 };
+    constexpr auto oscillatorFrequency = TestType{ 1024 };
+    const auto startPhase = GENERATE(take(10, random(TestType{ 0 }, TestType{ 1 })));
+
+    Phasor<TestType, PhaseAccumulation::FixedPoint> phasor{};
+    phasor.setSampleRate(sampleRate);
+    phasor.setFrequency(oscillatorFrequency);
+    phasor.setPhase(startPhase);
+
+    const auto firstOutput = phasor.perform();
+    for (size_t cycle = 0; cycle < 100000; ++cycle) {
+        std::array<TestType, 64> block{};
+        phasor.process(block.data(), block.size());
+        REQUIRE(block.back() == firstOutput);
+    }
+}
+
+TEMPLATE_TEST_CASE_SIG("Phasor Frequency Modulation", "[Phasor]", ((typename TestType, PhaseAccumulation Accumulation), TestType, Accumulation),
+                            (float, PhaseAccumulation::Index), (double, PhaseAccumulation::Index),
+                            (float, PhaseAccumulation::Incremental), (double, PhaseAccumulation::Incremental),
+                            (float, PhaseAccumulation::FixedPoint), (double, PhaseAccumulation::FixedPoint)) {
+    const auto sampleRate = GENERATE(TestType{ 44100.0 }, TestType{ 96000.0 });
+    constexpr auto oscillatorFrequency = TestType{ 440 };
+    constexpr size_t blockSize = 512;
+
+    Phasor<TestType, Accumulation> phasor{};
+    phasor.setFrequency(oscillatorFrequency);
+    phasor.setSampleRate(sampleRate);
+
+    //Include negative frequencies and frequencies above nyquist, which a modulator can easily produce
+    std::vector<TestType> frequencies(blockSize);
+    for (auto&& frequency : frequencies)
+        frequency = getBoundedRandom(-sampleRate, sampleRate*TestType{1.5});
+
+    std::vector<TestType> output(blockSize);
+    phasor.process(frequencies.data(), output.data(), blockSize);
+
+    const auto maximumError = Amplitude<TestType>{residualThreshold<TestType>}.count();
+    long double phasorReference = 0.0L;
+    for (size_t i = 0; i < blockSize; ++i) {
+        CHECK(getPhaseDistance(output[i], static_cast<TestType>(phasorReference)) < maximumError);
+        phasorReference += static_cast<long double>(frequencies[i])/static_cast<long double>(sampleRate);
+        phasorReference -= std::floor(phasorReference);
+    }
+
+    //Afterwards, the phasor should carry on from the same phase at the frequency it was set to
+    const auto phaseIncrement = static_cast<long double>(oscillatorFrequency/sampleRate);
+    for (size_t i = 0; i < blockSize; ++i) {
+        CHECK(getPhaseDistance(phasor.perform(), static_cast<TestType>(phasorReference)) < maximumError);
+        phasorReference += phaseIncrement;
+        phasorReference -= std::floor(phasorReference);
+    }
+}
+
+TEMPLATE_TEST_CASE_SIG("Phasor Frequency Ramp", "[Phasor]", ((typename TestType, PhaseAccumulation Accumulation), TestType, Accumulation),
+                            (float, PhaseAccumulation::Index), (double, PhaseAccumulation::Index),
+                            (float, PhaseAccumulation::Incremental), (double, PhaseAccumulation::Incremental),
+                            (float, PhaseAccumulation::FixedPoint), (double, PhaseAccumulation::FixedPoint)) {
+    const auto startFrequency = GENERATE(take(5, random(TestType{ 20 }, TestType{ 10000 })));
+    const auto targetFrequency = GENERATE(take(5, random(TestType{ 20 }, TestType{ 10000 })));
+    const auto rampLength = GENERATE(size_t{1}, size_t{64}, size_t{1000});
+    constexpr auto sampleRate = TestType{ 44100 };
+
+    Phasor<TestType, Accumulation> phasor{};
+    phasor.setSampleRate(sampleRate);
+    phasor.setFrequency(startFrequency);
+
+    //Run for a while first, so the ramp has to pick up the phase from part way through a cycle
+    std::vector<TestType> output(rampLength+1000);
+    phasor.process(output.data(), 100);
+    auto previousOutput = phasor.perform();
+
+    phasor.setTargetFrequency(targetFrequency, rampLength);
+    CHECK(phasor.isRamping());
+    phasor.process(output.data(), output.size());
+    CHECK_FALSE(phasor.isRamping());
+
+    //The phase increment between each sample should move linearly from the start frequency to the target
+    const auto startVelocity = static_cast<long double>(startFrequency)/sampleRate;
+    const auto rampStep = (static_cast<long double>(targetFrequency)/sampleRate-startVelocity)/static_cast<long double>(rampLength);
+    const auto maximumError = Amplitude<TestType>{residualThreshold<TestType>}.count();
+
+    long double phasorReference = previousOutput;
+    for (size_t i = 0; i <= rampLength; ++i) {
+        phasorReference += startVelocity+rampStep*static_cast<long double>(i);
+        phasorReference -= std::floor(phasorReference);
+        CHECK(getPhaseDistance(output[i], static_cast<TestType>(phasorReference)) < maximumError);
+    }
+
+    //And then carry on from where the ramp finished, the same as a phasor set straight to the target frequency
+    Phasor<TestType, Accumulation> targetPhasor{};
+    targetPhasor.setSampleRate(sampleRate);
+    targetPhasor.setFrequency(targetFrequency);
+    targetPhasor.setPhase(output[rampLength]);
+    for (size_t i = rampLength; i < output.size(); ++i)
+        CHECK(getPhaseDistance(output[i], targetPhasor.perform()) < maximumError);
+}
+
+TEMPLATE_TEST_CASE_SIG("Phasor Reset Ends A Ramp", "[Phasor]", ((typename TestType, PhaseAccumulation Accumulation), TestType, Accumulation),
+                            (float, PhaseAccumulation::Index), (double, PhaseAccumulation::Index),
+                            (float, PhaseAccumulation::Incremental), (double, PhaseAccumulation::Incremental),
+                            (float, PhaseAccumulation::FixedPoint), (double, PhaseAccumulation::FixedPoint)) {
+    constexpr auto sampleRate = TestType{ 44100 };
+    constexpr auto targetFrequency = TestType{ 1000 };
+
+    Phasor<TestType, Accumulation> phasor{};
+    phasor.setSampleRate(sampleRate);
+    phasor.setFrequency(TestType{ 100 });
+    phasor.setTargetFrequency(targetFrequency, 1000);
+    phasor.perform();
+    phasor.reset();
+
+    //After a reset, the phasor starts from 0 at the ramp's target, the same as a phasor set straight to it
+    REQUIRE_FALSE(phasor.isRamping());
+    REQUIRE(phasor.getPhaseVelocity() == Approx(phasor.getPhaseVelocity(targetFrequency)));
+
+    Phasor<TestType, Accumulation> targetPhasor{};
+    targetPhasor.setSampleRate(sampleRate);
+    targetPhasor.setFrequency(targetFrequency);
+    const auto maximumError = Amplitude<TestType>{residualThreshold<TestType>}.count();
+    for (size_t i = 0; i < 1000; ++i)
+        CHECK(getPhaseDistance(phasor.perform(), targetPhasor.perform()) < maximumError);
+}
+
+TEMPLATE_TEST_CASE_SIG("Phasor Wrap Events", "[Phasor]", ((typename TestType, PhaseAccumulation Accumulation), TestType, Accumulation),
+                            (float, PhaseAccumulation::Index), (double, PhaseAccumulation::Index),
+                            (float, PhaseAccumulation::Incremental), (double, PhaseAccumulation::Incremental),
+                            (float, PhaseAccumulation::FixedPoint), (double, PhaseAccumulation::FixedPoint)) {
+    const auto oscillatorFrequency = GENERATE(take(20, random(TestType{ 20 }, TestType{ 20000 })));
+    constexpr auto sampleRate = TestType{ 44100 };
+    constexpr size_t blockSize = 512;
+
+    Phasor<TestType, Accumulation> phasor{};
+    phasor.setSampleRate(sampleRate);
+    phasor.setFrequency(oscillatorFrequency);
+
+    std::vector<TestType> output(blockSize);
+    std::vector<SyncEvent<TestType>> events(blockSize);
+
+    //Nothing came before the phasor's first sample, so that isn't the start of a cycle
+    auto previousPhase = TestType{-1};
+    for (size_t block = 0; block < 10; ++block) {
+        const auto numEvents = phasor.processWithWraps(output.data(), blockSize, events.data(), events.size());
+
+        //Every sample that's lower than the one before it should have an event, and no others
+        size_t eventIndex = 0;
+        for (size_t i = 0; i < blockSize; ++i) {
+            if (output[i] < previousPhase) {
+                REQUIRE(eventIndex < numEvents);
+                CHECK(events[eventIndex].sampleIndex == i);
+                CHECK_THAT(events[eventIndex].fraction*phasor.getPhaseVelocity(), Catch::WithinAbs(output[i], 1e-6));
+                ++eventIndex;
+            }
+            previousPhase = output[i];
+        }
+        CHECK(eventIndex == numEvents);
+    }
+}
+
+//Setting the phase, or ramping the frequency, shouldn't make events for cycles that didn't start,
+// and an event's fraction should come from how far the phase actually moved over its sample
+TEMPLATE_TEST_CASE_SIG("Phasor Wrap Events Follow The Phase", "[Phasor]", ((typename TestType, PhaseAccumulation Accumulation), TestType, Accumulation),
+                            (float, PhaseAccumulation::Index), (double, PhaseAccumulation::Index),
+                            (float, PhaseAccumulation::Incremental), (double, PhaseAccumulation::Incremental),
+                            (float, PhaseAccumulation::FixedPoint), (double, PhaseAccumulation::FixedPoint)) {
+    constexpr auto sampleRate = TestType{ 44100 };
+    constexpr size_t blockSize = 512;
+
+    Phasor<TestType, Accumulation> phasor{};
+    phasor.setSampleRate(sampleRate);
+    phasor.setFrequency(TestType{ 1000 });
+
+    std::vector<TestType> output(blockSize);
+    std::vector<SyncEvent<TestType>> events(blockSize);
+
+    SECTION("Setting a small phase isn't a new cycle") {
+        for (size_t block = 0; block < 10; ++block) {
+            phasor.processWithWraps(output.data(), blockSize, events.data(), events.size());
+            phasor.setPhase(TestType{ .001 });
+
+            const auto numEvents = phasor.processWithWraps(output.data(), blockSize, events.data(), events.size());
+            REQUIRE(numEvents > 0);
+            CHECK(events[0].sampleIndex > 0);
+        }
+    }
+
+    SECTION("A block starting just after a wrap has an event on its first sample") {
+        //The phase is just under 1 at the end of the first block, so the second block's first sample starts a cycle
+        auto startPhase = -phasor.getPhaseVelocity()*(TestType{blockSize}-TestType{ .5 });
+        startPhase -= std::floor(startPhase);
+        phasor.setPhase(startPhase);
+        phasor.processWithWraps(output.data(), blockSize, events.data(), events.size());
+
+        const auto numEvents = phasor.processWithWraps(output.data(), blockSize, events.data(), events.size());
+        REQUIRE(numEvents > 0);
+        CHECK(events[0].sampleIndex == 0);
+        CHECK_THAT(events[0].fraction, Catch::WithinAbs(.5, 1e-2));
+    }
+
+    SECTION("Ramping the frequency") {
+        phasor.setTargetFrequency(TestType{ 10000 }, blockSize*4);
+
+        auto previousPhase = TestType{-1};
+        for (size_t block = 0; block < 4; ++block) {
+            const auto numEvents = phasor.processWithWraps(output.data(), blockSize, events.data(), events.size());
+
+            size_t eventIndex = 0;
+            for (size_t i = 0; i < blockSize; ++i) {
+                if (output[i] < previousPhase) {
+                    REQUIRE(eventIndex < numEvents);
+                    CHECK(events[eventIndex].sampleIndex == i);
+                    CHECK_THAT(events[eventIndex].fraction*(output[i]+TestType{1}-previousPhase), Catch::WithinAbs(output[i], 1e-6));
+                    ++eventIndex;
+                }
+                previousPhase = output[i];
+            }
+            CHECK(eventIndex == numEvents);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE_SIG("Phasor Sub-Sample Sync", "[Phasor]", ((typename TestType, PhaseAccumulation Accumulation), TestType, Accumulation),
+                            (float, PhaseAccumulation::Index), (double, PhaseAccumulation::Index),
+                            (float, PhaseAccumulation::Incremental), (double, PhaseAccumulation::Incremental),
+                            (float, PhaseAccumulation::FixedPoint), (double, PhaseAccumulation::FixedPoint)) {
+    const auto masterFrequency = GENERATE(take(10, random(TestType{ 20 }, TestType{ 5000 })));
+    const auto slaveFrequency = GENERATE(take(3, random(TestType{ 20 }, TestType{ 20000 })));
+    constexpr auto sampleRate = TestType{ 44100 };
+    constexpr size_t blockSize = 512;
+
+    Phasor<TestType, Accumulation> master{}, slave{};
+    master.setSampleRate(sampleRate);
+    master.setFrequency(masterFrequency);
+    slave.setSampleRate(sampleRate);
+    slave.setFrequency(slaveFrequency);
+
+    std::vector<TestType> masterOutput(blockSize), slaveOutput(blockSize);
+    std::vector<SyncEvent<TestType>> events(blockSize);
+
+    //The master starts at 0, so it starts a new cycle at every whole number of master periods
+    // Between those, the slave's phase is the time since the last one, in slave cycles
+    const auto masterVelocity = static_cast<long double>(masterFrequency/sampleRate);
+    const auto slaveVelocity = static_cast<long double>(slaveFrequency/sampleRate);
+
+    //The index strategy recalculates its phase from a float counter, which limits how close it can get
+    // The others are only limited by the precision of the phases they output
+    const auto maximumErrorLevel = Accumulation == PhaseAccumulation::Index ? TestType{-80}
+                                 : std::is_same_v<TestType, float> ? TestType{-100} : TestType{-120};
+    const auto maximumError = Amplitude<TestType>{Decibel<TestType>{maximumErrorLevel}}.count();
+
+    for (size_t block = 0; block < 10; ++block) {
+        const auto numEvents = master.processWithWraps(masterOutput.data(), blockSize, events.data(), events.size());
+        slave.processSynced(slaveOutput.data(), blockSize, events.data(), numEvents);
+
+        for (size_t i = 0; i < blockSize; ++i) {
+            const auto time = static_cast<long double>(block*blockSize+i);
+            const auto lastSync = std::floor(time*masterVelocity)/masterVelocity;
+            //Before the master's first wrap at sample 0, the slave runs freely from 0 too
+            auto slaveReference = (time-lastSync)*slaveVelocity;
+            slaveReference -= std::floor(slaveReference);
+
+            CHECK(getPhaseDistance(slaveOutput[i], static_cast<TestType>(slaveReference)) < maximumError);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE_SIG("Phasor Sync Clamps Events", "[Phasor]", ((typename TestType, PhaseAccumulation Accumulation), TestType, Accumulation),
+                            (float, PhaseAccumulation::Index), (double, PhaseAccumulation::Index),
+                            (float, PhaseAccumulation::Incremental), (double, PhaseAccumulation::Incremental),
+                            (float, PhaseAccumulation::FixedPoint), (double, PhaseAccumulation::FixedPoint)) {
+    constexpr auto sampleRate = TestType{ 44100 };
+    constexpr size_t blockSize = 16;
+
+    Phasor<TestType, Accumulation> phasor{}, reference{};
+    for (auto* p : {&phasor, &reference}) {
+        p->setSampleRate(sampleRate);
+        p->setFrequency(TestType{ 1000 });
+    }
+
+    //An event before the one ahead of it, and one past the end of the block,
+    // are the same as events at the sample before them and at the end of the block
+    const std::vector<SyncEvent<TestType>> events{{8, TestType{.5}}, {3, TestType{.5}}, {1000, TestType{.5}}};
+    const std::vector<SyncEvent<TestType>> clampedEvents{{8, TestType{.5}}, {8, TestType{.5}}, {blockSize, TestType{.5}}};
+
+    //The guard after the block has to be left alone
+    std::vector<TestType> output(blockSize*2, TestType{-1}), referenceOutput(blockSize);
+    phasor.processSynced(output.data(), blockSize, events.data(), events.size());
+    reference.processSynced(referenceOutput.data(), blockSize, clampedEvents.data(), clampedEvents.size());
+
+    REQUIRE(std::equal(referenceOutput.begin(), referenceOutput.end(), output.begin()));
+    REQUIRE(std::all_of(output.begin()+blockSize, output.end(), [](const auto& sample) { return sample == TestType{-1}; }));
+    //Both carry on from the same phase, synced at the end of the block
+    REQUIRE(phasor.getPhase() == reference.getPhase());
+}
+
+TEMPLATE_TEST_CASE_SIG("Phasor Reset Clears Wraps", "[Phasor]", ((typename TestType, PhaseAccumulation Accumulation), TestType, Accumulation),
+                            (float, PhaseAccumulation::Index), (double, PhaseAccumulation::Index),
+                            (float, PhaseAccumulation::Incremental), (double, PhaseAccumulation::Incremental),
+                            (float, PhaseAccumulation::FixedPoint), (double, PhaseAccumulation::FixedPoint)) {
+    constexpr size_t blockSize = 4;
+    constexpr auto sampleRate = TestType{ 44100 };
+
+    //A quarter of a cycle a sample, so each block ends on 3/4 and leaves the phasor at exactly 0
+    Phasor<TestType, Accumulation> phasor{};
+    phasor.setSampleRate(sampleRate);
+    phasor.setFrequency(sampleRate/TestType{4});
+
+    std::vector<TestType> output(blockSize);
+    std::vector<SyncEvent<TestType>> events(blockSize);
+    phasor.processWithWraps(output.data(), blockSize, events.data(), events.size());
+
+    //Starting from 0 after a reset isn't a new cycle, even though the phasor was left at 0 after 3/4 before the reset
+    phasor.reset();
+    REQUIRE(phasor.processWithWraps(output.data(), blockSize, events.data(), events.size()) == 0);
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "Oscillator.h"
+
+//PolyBLEP and PolyBLAMP shapers
+// These are the naive saw, square, and triangle shapers, with a small polynomial correction
+// added to the samples on either side of each discontinuity.
+// They need the oscillator's phase velocity to know how wide the correction is, which they get from setPhaseVelocity,
+// or for every sample from processModulated when the frequency is modulated
+// This doesn't remove as much aliasing as the band-limited wavetables,
+// but it only costs a few multiply-adds on the two samples around each discontinuity
+
+//Gets the correction for a jump in value of +2 at a phase of 0, i.e. from -1 to 1
+// This is the difference between an ideal step, and a step smoothed over the samples either side of the jump
+template<typename SampleType>
+SampleType polyBlep(const SampleType& phase, const SampleType& phaseVelocity) noexcept {
+    if (phase < phaseVelocity) {
+        const auto x = phase/phaseVelocity;
+        return x+x-x*x-SampleType{1};
+    }
+    else if (phase > SampleType{1}-phaseVelocity) {
+        const auto x = (phase-SampleType{1})/phaseVelocity;
+        return x*x+x+x+SampleType{1};
+    }
+    else
+        return SampleType{0};
+}
+
+//Gets the correction for a change in slope of +2 per sample at a phase of 0
+// This is the integral of polyBlep, so it smooths a corner instead of a step
+template<typename SampleType>
+SampleType polyBlamp(const SampleType& phase, const SampleType& phaseVelocity) noexcept {
+    if (phase < phaseVelocity) {
+        const auto x = phase/phaseVelocity-SampleType{1};
+        return SampleType{-1}/SampleType{3}*x*x*x;
+    }
+    else if (phase > SampleType{1}-phaseVelocity) {
+        const auto x = (phase-SampleType{1})/phaseVelocity+SampleType{1};
+        return SampleType{1}/SampleType{3}*x*x*x;
+    }
+    else
+        return SampleType{0};
+}
+
+//Wraps a phase that has been offset by less than a cycle back between 0 and 1
+template<typename SampleType>
+SampleType wrapPhase(const SampleType& phase) noexcept {
+    return phase < SampleType{1} ? phase : phase-SampleType{1};
+}
+
+//Anti-aliased sawtooth wave shaper
+template<typename SampleType>
+class PolyBlepSawShaper : public Shaper<SampleType>
+{
+public:
+    virtual SampleType perform(const SampleType& in) override {
+        return shape(in, phaseVelocity);
+    }
+
+    virtual void process(SampleType* buffer, size_t numSamples) override {
+        for (size_t i = 0; i < numSamples; ++i)
+            buffer[i] = PolyBlepSawShaper::perform(buffer[i]);
+    }
+
+    virtual void processModulated(SampleType* buffer, const SampleType* phaseVelocities, size_t numSamples) override {
+        for (size_t i = 0; i < numSamples; ++i)
+            buffer[i] = shape(buffer[i], phaseVelocities[i]);
+    }
+
+    virtual void setPhaseVelocity(const SampleType& newPhaseVelocity) override {
+        phaseVelocity = newPhaseVelocity;
+    }
+
+private:
+    SampleType phaseVelocity{0};
+
+    static SampleType shape(const SampleType& in, const SampleType& phaseVelocity) noexcept {
+        //A negative frequency moves the phase backwards, but the correction is just as wide
+        const auto velocity = std::abs(phaseVelocity);
+        //The saw drops by 2 at a phase of 0
+        return SawShaper<SampleType>{}.SawShaper<SampleType>::perform(in)
+               - polyBlep(in, velocity);
+    }
+};
+
+//Anti-aliased square wave shaper
+template<typename SampleType>
+class PolyBlepSquareShaper : public Shaper<SampleType>
+{
+public:
+    virtual SampleType perform(const SampleType& in) override {
+        return shape(in, phaseVelocity);
+    }
+
+    virtual void process(SampleType* buffer, size_t numSamples) override {
+        for (size_t i = 0; i < numSamples; ++i)
+            buffer[i] = PolyBlepSquareShaper::perform(buffer[i]);
+    }
+
+    virtual void processModulated(SampleType* buffer, const SampleType* phaseVelocities, size_t numSamples) override {
+        for (size_t i = 0; i < numSamples; ++i)
+            buffer[i] = shape(buffer[i], phaseVelocities[i]);
+    }
+
+    virtual void setPhaseVelocity(const SampleType& newPhaseVelocity) override {
+        phaseVelocity = newPhaseVelocity;
+    }
+
+private:
+    SampleType phaseVelocity{0};
+
+    static SampleType shape(const SampleType& in, const SampleType& phaseVelocity) noexcept {
+        const auto velocity = std::abs(phaseVelocity);
+        //The square rises by 2 at a phase of 0, and drops by 2 at a phase of .5
+        return SquareShaper<SampleType>{}.SquareShaper<SampleType>::perform(in)
+               + polyBlep(in, velocity)
+               - polyBlep(wrapPhase(in+SampleType{.5}), velocity);
+    }
+};
+
+//Anti-aliased triangle wave shaper
+template<typename SampleType>
+class PolyBlampTriShaper : public Shaper<SampleType>
+{
+public:
+    virtual SampleType perform(const SampleType& in) override {
+        return shape(in, phaseVelocity);
+    }
+
+    virtual void process(SampleType* buffer, size_t numSamples) override {
+        for (size_t i = 0; i < numSamples; ++i)
+            buffer[i] = PolyBlampTriShaper::perform(buffer[i]);
+    }
+
+    virtual void processModulated(SampleType* buffer, const SampleType* phaseVelocities, size_t numSamples) override {
+        for (size_t i = 0; i < numSamples; ++i)
+            buffer[i] = shape(buffer[i], phaseVelocities[i]);
+    }
+
+    virtual void setPhaseVelocity(const SampleType& newPhaseVelocity) override {
+        phaseVelocity = newPhaseVelocity;
+    }
+
+private:
+    SampleType phaseVelocity{0};
+
+    static SampleType shape(const SampleType& in, const SampleType& phaseVelocity) noexcept {
+        const auto velocity = std::abs(phaseVelocity);
+        //The triangle's slope changes by 8 per cycle at its corners:
+        // falling at the peak at a phase of .25, and rising at the trough at a phase of .75
+        //Running backwards, the peak is still a peak, so the change is the same size either way
+        //That's a change of 8 times the phase velocity per sample, and polyBlamp corrects a change of 2
+        const auto slopeChange = SampleType{4}*velocity;
+        return TriShaper<SampleType>{}.TriShaper<SampleType>::perform(in)
+               - slopeChange*polyBlamp(wrapPhase(in+SampleType{.75}), velocity)
+               + slopeChange*polyBlamp(wrapPhase(in+SampleType{.25}), velocity);
+    }
+};
\ No newline at end of file
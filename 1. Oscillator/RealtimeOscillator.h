@@ -0,0 +1,153 @@
+#pragma once
+
+#include "Oscillator.h"
+
+#include <array>
+#include <juce_core/juce_core.h>
+
+//An oscillator that's controlled from a different thread to the one it's processed on, like a UI or message thread
+// The control thread never touches the oscillator itself. Each change is posted to a lock free single producer,
+// single consumer queue, and the audio thread applies the changes that are waiting at the start of each block.
+// Shapers that get replaced are sent back through a second queue, so they're deleted on the control thread
+// instead of deallocating on the audio thread
+//Each oscillator should only have one control thread and one audio thread
+template<typename SampleType, PhaseAccumulation Accumulation = PhaseAccumulation::Index, int QueueSize = 64>
+class RealtimeOscillator
+{
+    using ShaperType = Shaper<SampleType>;
+
+public:
+    //Control thread
+    // These return false if the queue is full, in which case nothing changes and the change can be posted again later
+
+    bool setSampleRate(const SampleType& newPerformRate) {
+        return post(MessageType::SampleRateChange, newPerformRate);
+    }
+
+    bool setFrequency(const SampleType& newFrequency) {
+        return post(MessageType::FrequencyChange, newFrequency);
+    }
+
+    bool setPhase(const SampleType& newPhase) {
+        return post(MessageType::PhaseChange, newPhase);
+    }
+
+    //The new shaper is only moved from if it's posted, so a shaper that didn't fit in the queue can be posted again
+    // This takes a pointer to the derived shaper, because converting it to a pointer to ShaperType
+    // would move it into a temporary that deletes it if the post fails
+    template<typename NewShaperType>
+    bool setWaveform(std::unique_ptr<NewShaperType>&& newShaper) {
+        releaseRetiredShapers();
+        return post(MessageType::WaveformChange, SampleType{0}, std::move(newShaper));
+    }
+
+    //Deletes the shapers the audio thread has finished with
+    // setWaveform calls this, but it's worth calling from a timer too, so old shapers don't wait for the next waveform change
+    void releaseRetiredShapers() {
+        int start1, size1, start2, size2;
+        retiredFifo.prepareToRead(retiredFifo.getNumReady(), start1, size1, start2, size2);
+
+        for (auto i = start1; i < start1+size1; ++i)
+            retiredShapers[static_cast<size_t>(i)].reset();
+        for (auto i = start2; i < start2+size2; ++i)
+            retiredShapers[static_cast<size_t>(i)].reset();
+
+        retiredFifo.finishedRead(size1+size2);
+    }
+
+    //Audio thread
+
+    //Applies every change that the control thread has posted since the last block
+    // process calls this, so it only needs calling directly when using perform
+    void applyPendingChanges() noexcept {
+        int start1, size1, start2, size2;
+        messageFifo.prepareToRead(messageFifo.getNumReady(), start1, size1, start2, size2);
+
+        //Stop at a waveform change if there's nowhere to send the old shaper, and pick it up again next block
+        auto numApplied = 0;
+        for (auto i = start1; i < start1+size1 && apply(messages[static_cast<size_t>(i)]); ++i)
+            ++numApplied;
+        if (numApplied == size1)
+            for (auto i = start2; i < start2+size2 && apply(messages[static_cast<size_t>(i)]); ++i)
+                ++numApplied;
+
+        messageFifo.finishedRead(numApplied);
+    }
+
+    SampleType perform() noexcept { return oscillator.perform(); }
+
+    void process(SampleType* buffer, size_t numSamples) noexcept {
+        applyPendingChanges();
+        oscillator.process(buffer, numSamples);
+    }
+
+    void process(const SampleType* frequencies, SampleType* buffer, size_t numSamples) noexcept {
+        applyPendingChanges();
+        oscillator.process(frequencies, buffer, numSamples);
+    }
+
+private:
+    enum MessageType {
+        SampleRateChange, FrequencyChange, PhaseChange, WaveformChange
+    };
+
+    struct Message
+    {
+        MessageType type;
+        SampleType value;
+        std::unique_ptr<ShaperType> shaper;
+    };
+
+    Oscillator<SampleType, Accumulation> oscillator{};
+
+    juce::AbstractFifo messageFifo{QueueSize}, retiredFifo{QueueSize};
+    std::array<Message, QueueSize> messages{};
+    std::array<std::unique_ptr<ShaperType>, QueueSize> retiredShapers{};
+
+    //The slots in the queues are only written by one thread at a time, and always hold empty pointers
+    // by the time they're written to, so moving into them never deletes a shaper
+    template<typename NewShaperType = ShaperType>
+    bool post(MessageType type, const SampleType& value, std::unique_ptr<NewShaperType>&& shaper = nullptr) {
+        int start1, size1, start2, size2;
+        messageFifo.prepareToWrite(1, start1, size1, start2, size2);
+        if (size1 == 0)
+            return false;
+
+        auto& message = messages[static_cast<size_t>(start1)];
+        message.type = type;
+        message.value = value;
+        message.shaper = std::move(shaper);
+        messageFifo.finishedWrite(1);
+        return true;
+    }
+
+    bool apply(Message& message) noexcept {
+        switch (message.type) {
+            case MessageType::SampleRateChange:
+                oscillator.setSampleRate(message.value);
+                return true;
+            case MessageType::FrequencyChange:
+                oscillator.setFrequency(message.value);
+                return true;
+            case MessageType::PhaseChange:
+                oscillator.setPhase(message.value);
+                return true;
+            case MessageType::WaveformChange:
+                return swapWaveform(message.shaper);
+        }
+        return true;
+    }
+
+    //Swaps in the new shaper, leaving the old one in the message until it can be moved to the retired queue
+    bool swapWaveform(std::unique_ptr<ShaperType>& newShaper) noexcept {
+        int start1, size1, start2, size2;
+        retiredFifo.prepareToWrite(1, start1, size1, start2, size2);
+        if (size1 == 0)
+            return false;
+
+        oscillator.setWaveform(std::move(newShaper));
+        retiredShapers[static_cast<size_t>(start1)] = std::move(newShaper);
+        retiredFifo.finishedWrite(1);
+        return true;
+    }
+};
@@ -0,0 +1,126 @@
+#include "RealtimeOscillator.h"
+
+#include <catch2/catch.hpp>
+
+#include "OscillatorUtilities.h"
+#include "OscillatorTestConstants.h"
+#include "../Utilities/DecibelMatchers.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//Counts how many shapers were deleted, and how many of those were deleted on the audio thread
+struct ShaperDeletions
+{
+    std::atomic<int> total{0}, onAudioThread{0};
+    std::thread::id audioThread{};
+};
+
+template<typename SampleType>
+class TrackedSawShaper : public SawShaper<SampleType>
+{
+public:
+    explicit TrackedSawShaper(ShaperDeletions& deletions) : deletions(deletions) {}
+
+    ~TrackedSawShaper() override {
+        ++deletions.total;
+        if (std::this_thread::get_id() == deletions.audioThread)
+            ++deletions.onAudioThread;
+    }
+
+private:
+    ShaperDeletions& deletions;
+};
+
+TEMPLATE_TEST_CASE("Realtime Oscillator Applies Changes", "[Oscillator]", float, double) {
+    const auto oscillatorFrequency = GENERATE(take(10, random(TestType{ 0 }, TestType{ 20000 })));
+    constexpr auto sampleRate = TestType{ 44100 };
+    constexpr size_t blockSize = 512;
+
+    RealtimeOscillator<TestType> realtimeOsc{};
+    CHECK(realtimeOsc.setSampleRate(sampleRate));
+    CHECK(realtimeOsc.setFrequency(oscillatorFrequency));
+    CHECK(realtimeOsc.setWaveform(std::make_unique<SinShaper<TestType>>()));
+
+    Oscillator<TestType> referenceOsc{};
+    referenceOsc.setSampleRate(sampleRate);
+    referenceOsc.setFrequency(oscillatorFrequency);
+    referenceOsc.setWaveform(std::make_unique<SinShaper<TestType>>());
+
+    std::vector<TestType> block(blockSize), reference(blockSize);
+    for (size_t i = 0; i < 10; ++i) {
+        realtimeOsc.process(block.data(), block.size());
+        referenceOsc.process(reference.data(), reference.size());
+
+        for (size_t j = 0; j < blockSize; ++j)
+            CHECK_THAT(Decibel<TestType>{Amplitude{block[j]}}, ResidualDecibels<TestType>(reference[j], residualThreshold<TestType>));
+    }
+}
+
+TEMPLATE_TEST_CASE("Realtime Oscillator Queue", "[Oscillator]", float, double) {
+    //The oscillator deletes its last shaper when it's destroyed, so this needs to outlive it
+    ShaperDeletions deletions{};
+    RealtimeOscillator<TestType, PhaseAccumulation::Index, 8> realtimeOsc{};
+    std::vector<TestType> block(64);
+
+    SECTION("Changes are refused when the queue is full") {
+        //A fifo of 8 can hold 7 changes
+        for (auto i = 0; i < 7; ++i)
+            CHECK(realtimeOsc.setFrequency(TestType{ 440 }));
+        CHECK_FALSE(realtimeOsc.setFrequency(TestType{ 440 }));
+
+        realtimeOsc.process(block.data(), block.size());
+        CHECK(realtimeOsc.setFrequency(TestType{ 440 }));
+    }
+
+    SECTION("Replaced shapers are kept until the control thread releases them") {
+        for (auto i = 0; i < 3; ++i)
+            CHECK(realtimeOsc.setWaveform(std::make_unique<TrackedSawShaper<TestType>>(deletions)));
+        realtimeOsc.process(block.data(), block.size());
+
+        //The second and third shapers each replaced the one before, but neither was deleted by process
+        CHECK(deletions.total == 0);
+        realtimeOsc.releaseRetiredShapers();
+        CHECK(deletions.total == 2);
+    }
+}
+
+TEMPLATE_TEST_CASE("Realtime Oscillator Threads", "[Oscillator]", float, double) {
+    constexpr auto numChanges = 2000;
+
+    ShaperDeletions deletions{};
+    RealtimeOscillator<TestType, PhaseAccumulation::Incremental> realtimeOsc{};
+    std::atomic<bool> audioThreadStarted{false}, controlThreadFinished{false};
+
+    std::thread audioThread{[&] {
+        deletions.audioThread = std::this_thread::get_id();
+        audioThreadStarted = true;
+
+        std::vector<TestType> block(64);
+        while (!controlThreadFinished)
+            realtimeOsc.process(block.data(), block.size());
+        //Pick up anything that was posted after the last block
+        realtimeOsc.process(block.data(), block.size());
+    }};
+
+    while (!audioThreadStarted)
+        std::this_thread::yield();
+
+    //Change the waveform and frequency as fast as the audio thread will take them
+    for (auto i = 0; i < numChanges; ++i) {
+        auto newShaper = std::make_unique<TrackedSawShaper<TestType>>(deletions);
+        while (!realtimeOsc.setWaveform(std::move(newShaper)))
+            std::this_thread::yield();
+        while (!realtimeOsc.setFrequency(static_cast<TestType>(20+i)))
+            std::this_thread::yield();
+    }
+
+    controlThreadFinished = true;
+    audioThread.join();
+    realtimeOsc.releaseRetiredShapers();
+
+    //Every shaper but the last has been replaced, and they were all deleted on this thread
+    CHECK(deletions.total == numChanges-1);
+    CHECK(deletions.onAudioThread == 0);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Oscillator.h"
+
+#include <array>
+
+// Tagged value for choosing how accurately a sin shaper calculates its output
+// ExactSin calls std::sin, and the others are polynomials whose error stays below the level in their name,
+// matching the thresholds we use in our tests. Cheaper tiers use fewer terms
+// i.e. ApproximateSinShaper<float, SinAccuracy::Accurate96dB>
+enum SinAccuracy {
+    ExactSin, Accurate120dB, Accurate96dB, Accurate60dB
+};
+
+//The odd coefficients of a polynomial in t that approximates sin(t*pi/2) between -1 and 1
+// These are minimax fits, so the error ripples evenly across the range instead of growing towards the edges
+//  9th order: max error 3.3e-9 (-169dB), the rest of the error comes from rounding in float
+//  7th order: max error 5.9e-7 (-124dB)
+//  5th order: max error 6.8e-5 (-83dB)
+template<SinAccuracy Accuracy>
+constexpr auto getSinCoefficients() noexcept {
+    static_assert(Accuracy != SinAccuracy::ExactSin, "The exact sin doesn't use a polynomial");
+
+    if constexpr (Accuracy == SinAccuracy::Accurate120dB)
+        return std::array<double, 5>{1.5707962900223709, -0.6459633598659001, 0.07968848054037213,
+                                     -0.004672227923299868, 0.00015082056456927598};
+    else if constexpr (Accuracy == SinAccuracy::Accurate96dB)
+        return std::array<double, 4>{1.5707910110756262, -0.645892849548791, 0.07943434461787048,
+                                     -0.004333095293138412};
+    else
+        return std::array<double, 3>{1.570320019159875, -0.6421131670105218, 0.07186085425154948};
+}
+
+//Gets sin(phase*2pi) for a phase between 0 and 1, like SinShaper
+// The phase is folded into a triangle wave, which lines up each quarter of the cycle with the same odd polynomial.
+// There are no branches, so a loop of these can be vectorized
+template<SinAccuracy Accuracy, typename SampleType>
+SampleType approximateSin(const SampleType& phase) noexcept {
+    if constexpr (Accuracy == SinAccuracy::ExactSin) {
+        return std::sin(phase*juce::MathConstants<SampleType>::twoPi);
+    }
+    else {
+        //Shift the phase so the peak is at 0, and wrap it between -.5 and .5
+        auto shiftedPhase = phase-SampleType{.25};
+        shiftedPhase -= static_cast<SampleType>(shiftedPhase >= SampleType{.5});
+        //This goes from 0 at the start of the cycle, up to 1 at the peak, and down to -1 at the trough
+        const auto t = SampleType{1}-SampleType{4}*std::abs(shiftedPhase);
+        const auto tSquared = t*t;
+
+        constexpr auto coefficients = getSinCoefficients<Accuracy>();
+        auto result = static_cast<SampleType>(coefficients.back());
+        for (size_t i = coefficients.size()-1; i-- > 0;)
+            result = result*tSquared+static_cast<SampleType>(coefficients[i]);
+        return result*t;
+    }
+}
+
+//Replaces a block of phases between 0 and 1 with their sin values
+template<SinAccuracy Accuracy, typename SampleType>
+void approximateSin(SampleType* buffer, size_t numSamples) noexcept {
+    for (size_t i = 0; i < numSamples; ++i)
+        buffer[i] = approximateSin<Accuracy>(buffer[i]);
+}
+
+//A sin wave shaper with a selectable accuracy
+// Tests can keep using SinShaper, or ExactSin, as a reference, while voices use a cheaper tier
+template<typename SampleType, SinAccuracy Accuracy>
+class ApproximateSinShaper : public Shaper<SampleType>
+{
+public:
+    virtual SampleType perform(const SampleType& in) override {
+        return approximateSin<Accuracy>(in);
+    }
+
+    virtual void process(SampleType* buffer, size_t numSamples) override {
+        approximateSin<Accuracy>(buffer, numSamples);
+    }
+};
+
+//Each accuracy tier as a shaper with a single template argument, so they can be used with StaticOscillator
+template<typename SampleType>
+using SinShaper120dB = ApproximateSinShaper<SampleType, SinAccuracy::Accurate120dB>;
+template<typename SampleType>
+using SinShaper96dB = ApproximateSinShaper<SampleType, SinAccuracy::Accurate96dB>;
+template<typename SampleType>
+using SinShaper60dB = ApproximateSinShaper<SampleType, SinAccuracy::Accurate60dB>;
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "Oscillator.h"
+
+#include <variant>
+
+//A shaper that holds any of our waveforms by value
+// Changing the waveform is an assignment instead of a heap allocation,
+// and the active waveform is only looked up once per block when processing
+template<typename SampleType>
+class ShaperVariant
+{
+public:
+    using VariantType = std::variant<Shaper<SampleType>,
+                                     SinShaper<SampleType>,
+                                     TriShaper<SampleType>,
+                                     SquareShaper<SampleType>,
+                                     SawShaper<SampleType>>;
+
+    ShaperVariant() = default;
+
+    template<typename NewShaper>
+    ShaperVariant(NewShaper newShaper) : shaper(std::move(newShaper)) {}
+
+    SampleType perform(const SampleType& in) noexcept {
+        return std::visit([&in](auto& currentShaper) {
+            using CurrentShaper = std::decay_t<decltype(currentShaper)>;
+            return currentShaper.CurrentShaper::perform(in);
+        }, shaper);
+    }
+
+    void process(SampleType* buffer, size_t numSamples) noexcept {
+        std::visit([buffer, numSamples](auto& currentShaper) {
+            using CurrentShaper = std::decay_t<decltype(currentShaper)>;
+            currentShaper.CurrentShaper::process(buffer, numSamples);
+        }, shaper);
+    }
+
+    void setPhaseVelocity(const SampleType& newPhaseVelocity) noexcept {
+        std::visit([&newPhaseVelocity](auto& currentShaper) {
+            using CurrentShaper = std::decay_t<decltype(currentShaper)>;
+            currentShaper.CurrentShaper::setPhaseVelocity(newPhaseVelocity);
+        }, shaper);
+    }
+
+    void processModulated(SampleType* buffer, const SampleType* phaseVelocities, size_t numSamples) noexcept {
+        std::visit([buffer, phaseVelocities, numSamples](auto& currentShaper) {
+            using CurrentShaper = std::decay_t<decltype(currentShaper)>;
+            currentShaper.CurrentShaper::processModulated(buffer, phaseVelocities, numSamples);
+        }, shaper);
+    }
+
+    constexpr const auto& getVariant() const noexcept { return shaper; }
+
+private:
+    VariantType shaper{};
+};
+
+//An oscillator with the same interface as Oscillator, but whose shaper is chosen at compile time
+// The shaper is held by value and its functions are called non-virtually,
+// so the waveform's body can be compiled directly into the perform and process loops
+//i.e. StaticOscillator<float, SinShaper>, or StaticOscillator<float, ShaperVariant> to switch waveforms without allocating
+template<typename SampleType,
+         template<typename> class ShaperTemplate = Shaper,
+         PhaseAccumulation Accumulation = PhaseAccumulation::Index>
+class StaticOscillator
+{
+public:
+    using ShaperType = ShaperTemplate<SampleType>;
+
+    void setSampleRate(const SampleType& newPerformRate) noexcept {
+        phasor.setSampleRate(newPerformRate);
+        shaper.ShaperType::setPhaseVelocity(phasor.getPhaseVelocity());
+    }
+
+    void reset() noexcept {
+        phasor.reset();
+    }
+
+    void setFrequency(const SampleType& newFrequency) noexcept {
+        phasor.setFrequency(newFrequency);
+        shaper.ShaperType::setPhaseVelocity(phasor.getPhaseVelocity());
+    }
+
+    //Glide to a new frequency over numSamples. The shaper's phase velocity is updated once per block while it ramps
+    void setTargetFrequency(const SampleType& newFrequency, size_t numSamples) noexcept {
+        phasor.setTargetFrequency(newFrequency, numSamples);
+        shaper.ShaperType::setPhaseVelocity(phasor.getPhaseVelocity());
+    }
+
+    void setPhase(const SampleType& newPhase) noexcept {
+        phasor.setPhase(newPhase);
+    }
+
+    void setWaveform(ShaperType newShaper) noexcept {
+        shaper = std::move(newShaper);
+        shaper.ShaperType::setPhaseVelocity(phasor.getPhaseVelocity());
+    }
+
+    constexpr const auto& getWaveform() const noexcept {
+        return shaper;
+    }
+
+    SampleType perform(const SampleType& newPhase) noexcept {
+        setPhase(newPhase);
+        return perform();
+    }
+
+    //Qualifying the call with the shaper's type stops it from going through the vtable
+    SampleType perform() noexcept { return shaper.ShaperType::perform(phasor.perform()); }
+
+    void process(SampleType* buffer, size_t numSamples) noexcept {
+        const auto wasRamping = phasor.isRamping();
+        phasor.process(buffer, numSamples);
+        if (wasRamping)
+            shaper.ShaperType::setPhaseVelocity(phasor.getPhaseVelocity());
+        shaper.ShaperType::process(buffer, numSamples);
+    }
+
+    //Fill a block with the oscillator's output, frequency modulated by a separate frequency for every sample
+    // See Oscillator::process, the shaper is given the phase velocity of every sample
+    void process(const SampleType* frequencies, SampleType* buffer, size_t numSamples) noexcept {
+        std::array<SampleType, modulationChunkSize> velocities;
+        for (size_t start = 0; start < numSamples; start += modulationChunkSize) {
+            const auto chunkSize = std::min(modulationChunkSize, numSamples-start);
+            for (size_t i = 0; i < chunkSize; ++i)
+                velocities[i] = std::abs(phasor.getPhaseVelocity(frequencies[start+i]));
+
+            phasor.process(frequencies+start, buffer+start, chunkSize);
+            shaper.ShaperType::processModulated(buffer+start, velocities.data(), chunkSize);
+        }
+        shaper.ShaperType::setPhaseVelocity(phasor.getPhaseVelocity());
+    }
+
+private:
+    static constexpr size_t modulationChunkSize = 64;
+
+    Phasor<SampleType, Accumulation> phasor{};
+    ShaperType shaper{};
+};
@@ -0,0 +1,83 @@
+#include "StaticOscillator.h"
+
+#include <catch2/catch.hpp>
+
+#include "OscillatorUtilities.h"
+#include "OscillatorTestConstants.h"
+#include "../Utilities/DecibelMatchers.h"
+
+//Checks that a statically dispatched oscillator matches a dynamically dispatched oscillator using the same waveform
+template<typename T, template<typename> class ShaperTemplate>
+void checkStaticOscillatorMatches(const T& oscillatorFrequency, const T& sampleRate) {
+    Oscillator<T> dynamicOsc{};
+    dynamicOsc.setWaveform(std::make_unique<ShaperTemplate<T>>());
+    dynamicOsc.setFrequency(oscillatorFrequency);
+    dynamicOsc.setSampleRate(sampleRate);
+
+    StaticOscillator<T, ShaperTemplate> staticOsc{};
+    staticOsc.setFrequency(oscillatorFrequency);
+    staticOsc.setSampleRate(sampleRate);
+
+    for (size_t i = 0; i < numIterations; ++i) {
+        const auto reference = dynamicOsc.perform();
+        const Decibel<T> oscLevel = Amplitude{staticOsc.perform()};
+        CHECK_THAT(oscLevel, ResidualDecibels<T>(reference, residualThreshold<T>));
+    }
+}
+
+TEMPLATE_TEST_CASE("Static Oscillator Waveforms", "[Oscillator]", float, double) {
+    const auto oscillatorFrequency = GENERATE(take(10, random(TestType{ 0 }, TestType{ 20000 })));
+    constexpr auto sampleRate = TestType{ 44100 };
+
+    SECTION("Identity") { checkStaticOscillatorMatches<TestType, Shaper>(oscillatorFrequency, sampleRate); }
+    SECTION("Sin")      { checkStaticOscillatorMatches<TestType, SinShaper>(oscillatorFrequency, sampleRate); }
+    SECTION("Tri")      { checkStaticOscillatorMatches<TestType, TriShaper>(oscillatorFrequency, sampleRate); }
+    SECTION("Square")   { checkStaticOscillatorMatches<TestType, SquareShaper>(oscillatorFrequency, sampleRate); }
+    SECTION("Saw")      { checkStaticOscillatorMatches<TestType, SawShaper>(oscillatorFrequency, sampleRate); }
+}
+
+TEMPLATE_TEST_CASE("Static Oscillator Variant Waveforms", "[Oscillator]", float, double) {
+    constexpr auto oscillatorFrequency = TestType{ 440 };
+    constexpr auto sampleRate = TestType{ 44100 };
+    constexpr size_t blockSize = 512;
+
+    StaticOscillator<TestType, ShaperVariant> variantOsc{};
+    variantOsc.setFrequency(oscillatorFrequency);
+    variantOsc.setSampleRate(sampleRate);
+
+    Oscillator<TestType> dynamicOsc{};
+    dynamicOsc.setFrequency(oscillatorFrequency);
+    dynamicOsc.setSampleRate(sampleRate);
+
+    std::vector<TestType> block(blockSize);
+
+    //Switch both oscillators between each waveform, and check that they stay in step with each other
+    const auto checkBlock = [&]() {
+        variantOsc.process(block.data(), block.size());
+        for (auto&& sample : block)
+            CHECK_THAT(Decibel<TestType>{Amplitude{sample}},
+                       ResidualDecibels<TestType>(dynamicOsc.perform(), residualThreshold<TestType>));
+    };
+
+    checkBlock();
+
+    variantOsc.setWaveform(SinShaper<TestType>{});
+    dynamicOsc.setWaveform(std::make_unique<SinShaper<TestType>>());
+    CHECK(std::holds_alternative<SinShaper<TestType>>(variantOsc.getWaveform().getVariant()));
+    checkBlock();
+
+    variantOsc.setWaveform(TriShaper<TestType>{});
+    dynamicOsc.setWaveform(std::make_unique<TriShaper<TestType>>());
+    CHECK(std::holds_alternative<TriShaper<TestType>>(variantOsc.getWaveform().getVariant()));
+    checkBlock();
+
+    variantOsc.setWaveform(SquareShaper<TestType>{});
+    dynamicOsc.setWaveform(std::make_unique<SquareShaper<TestType>>());
+    CHECK(std::holds_alternative<SquareShaper<TestType>>(variantOsc.getWaveform().getVariant()));
+    checkBlock();
+
+    variantOsc.setWaveform(SawShaper<TestType>{});
+    dynamicOsc.setWaveform(std::make_unique<SawShaper<TestType>>());
+    CHECK(std::holds_alternative<SawShaper<TestType>>(variantOsc.getWaveform().getVariant()));
+    checkBlock();
+}
@@ -1,4 +1,7 @@
 #include "Oscillator.h"
+#include "WavetableShaper.h"
+#include "PolyBlepShaper.h"
+#include "SinApproximation.h"
 
 #include <catch2/catch.hpp>
 
@@ -134,3 +137,218 @@ TEMPLATE_TEST_CASE("Saw Wave", "[Oscillator]", float, double) {
                || closeToEdge({oscOut, ref}, TestType{-1}, TestType{1})));
     }
 }
+
+template<typename T>
+std::unique_ptr<Shaper<T>> makeShaper(size_t index) {
+    switch (index) {
+        case 0:  return std::make_unique<SinShaper<T>>();
+        case 1:  return std::make_unique<TriShaper<T>>();
+        case 2:  return std::make_unique<SquareShaper<T>>();
+        case 3:  return std::make_unique<SawShaper<T>>();
+        default: return std::make_unique<Shaper<T>>();
+    }
+}
+
+TEMPLATE_TEST_CASE("Process Oscillator Blocks", "[Oscillator]", float, double) {
+    const auto oscillatorFrequency = GENERATE(take(10, random(TestType{ 0 }, TestType{ 20000 })));
+    constexpr auto sampleRate = TestType{ 44100 };
+    const auto shaperIndex = GENERATE(range(size_t{0}, size_t{5}));
+    const auto blockSize = GENERATE(size_t{1}, size_t{64}, size_t{512}, size_t{4096});
+
+    //Run one oscillator a sample at a time, and another a block at a time
+    Oscillator<TestType> sampleOsc{}, blockOsc{};
+    for (auto* osc : {&sampleOsc, &blockOsc}) {
+        osc->setWaveform(makeShaper<TestType>(shaperIndex));
+        osc->setFrequency(oscillatorFrequency);
+        osc->setSampleRate(sampleRate);
+    }
+
+    std::vector<TestType> block(blockSize);
+
+    for (size_t i = 0; i < numIterations; i += blockSize) {
+        const auto numSamples = std::min(blockSize, numIterations-i);
+        blockOsc.process(block.data(), numSamples);
+
+        //Both oscillators should produce the same samples
+        for (size_t j = 0; j < numSamples; ++j) {
+            const auto reference = sampleOsc.perform();
+            CHECK_THAT(Decibel<TestType>{Amplitude{block[j]}},
+                       ResidualDecibels<TestType>(reference, residualThreshold<TestType>));
+        }
+    }
+}
+
+//Render a whole number of cycles of an oscillator, sized for measureAliasing
+//Using a power of 2 for the sample rate's denominator means the phase increment is exact, so the signal is exactly periodic
+template<typename T>
+auto renderPeriodicWaveform(std::unique_ptr<Shaper<T>> shaper, size_t fundamentalBin, size_t numSamples) {
+    constexpr auto sampleRate = T{ 44100 };
+
+    Oscillator<T> osc{};
+    osc.setWaveform(std::move(shaper));
+    osc.setSampleRate(sampleRate);
+    osc.setFrequency(static_cast<T>(fundamentalBin)*sampleRate/static_cast<T>(numSamples));
+
+    std::vector<T> signal(numSamples);
+    osc.process(signal.data(), signal.size());
+    return signal;
+}
+
+//Check that a shaper aliases at least minimumReduction decibels less than the naive shaper it stands in for,
+// and no more than maximumAliasing
+//211 is prime, so none of the aliased harmonics fold back onto a harmonic
+// this puts the fundamental at around 2.3kHz
+template<typename T>
+void checkAliasingReduced(std::unique_ptr<Shaper<T>> naiveShaper, std::unique_ptr<Shaper<T>> shaper,
+                          const T& minimumReduction, const T& maximumAliasing = std::numeric_limits<T>::infinity()) {
+    constexpr size_t fundamentalBin = 211;
+    constexpr size_t numSamples = 4096;
+
+    const Decibel<T> naiveAliasing = Amplitude{measureAliasing(renderPeriodicWaveform<T>(std::move(naiveShaper), fundamentalBin, numSamples), fundamentalBin)};
+    const Decibel<T> aliasing = Amplitude{measureAliasing(renderPeriodicWaveform<T>(std::move(shaper), fundamentalBin, numSamples), fundamentalBin)};
+
+    INFO("Naive aliasing: " << naiveAliasing << ", aliasing: " << aliasing);
+    CHECK(aliasing.count() < maximumAliasing);
+    CHECK(aliasing.count() < naiveAliasing.count()-minimumReduction);
+}
+
+TEMPLATE_TEST_CASE("Band-Limited Wavetable Aliasing", "[Oscillator]", float, double) {
+    constexpr auto minimumReduction = TestType{30};
+    constexpr auto maximumAliasing = TestType{-60};
+
+    SECTION("Saw") {
+        checkAliasingReduced<TestType>(std::make_unique<SawShaper<TestType>>(), std::make_unique<BandLimitedSawShaper<TestType>>(), minimumReduction, maximumAliasing);
+    }
+    SECTION("Square") {
+        checkAliasingReduced<TestType>(std::make_unique<SquareShaper<TestType>>(), std::make_unique<BandLimitedSquareShaper<TestType>>(), minimumReduction, maximumAliasing);
+    }
+    SECTION("Tri") {
+        checkAliasingReduced<TestType>(std::make_unique<TriShaper<TestType>>(), std::make_unique<BandLimitedTriShaper<TestType>>(), minimumReduction, maximumAliasing);
+    }
+}
+
+//At low frequencies the band-limited tables hold hundreds of harmonics, so they should follow the naive waveforms closely
+TEMPLATE_TEST_CASE("Band-Limited Wavetable Shape", "[Oscillator]", float, double) {
+    const auto phase = GENERATE(take(1000, random(TestType{ 0 }, TestType{ 1 })));
+
+    const auto getDistanceFromEdges = [&phase](std::initializer_list<TestType> edges) {
+        auto distance = TestType{1};
+        for (auto&& edge : edges)
+            distance = std::min(distance, getPhaseDistance(phase, edge));
+        return distance;
+    };
+
+    //The tables have around 512 harmonics, so stay a few of their cycles away from any jumps to avoid the ringing there
+    constexpr auto ringingWidth = TestType{ .01 };
+
+    SECTION("Saw") {
+        BandLimitedSawShaper<TestType> shaper{};
+        if (getDistanceFromEdges({TestType{0}}) > ringingWidth)
+            CHECK_THAT(shaper.perform(phase), Catch::WithinAbs(SawShaper<TestType>{}.perform(phase), .05));
+    }
+    SECTION("Square") {
+        BandLimitedSquareShaper<TestType> shaper{};
+        if (getDistanceFromEdges({TestType{0}, TestType{.5}}) > ringingWidth)
+            CHECK_THAT(shaper.perform(phase), Catch::WithinAbs(SquareShaper<TestType>{}.perform(phase), .05));
+    }
+    SECTION("Tri") {
+        BandLimitedTriShaper<TestType> shaper{};
+        CHECK_THAT(shaper.perform(phase), Catch::WithinAbs(TriShaper<TestType>{}.perform(phase), .01));
+    }
+}
+
+//Phases outside of 0 to 1, like the negative phases the index phasor gives after setting a negative phase,
+// should wrap round the table rather than reading outside of it
+TEMPLATE_TEST_CASE("Band-Limited Wavetable Phase Range", "[Oscillator]", float, double) {
+    const auto phase = GENERATE(take(100, random(TestType{ 0 }, TestType{ 1 })));
+    BandLimitedSawShaper<TestType> shaper{};
+
+    CHECK_THAT(shaper.perform(phase-TestType{1}), Catch::WithinAbs(shaper.perform(phase), 1e-4));
+    CHECK_THAT(shaper.perform(phase+TestType{1}), Catch::WithinAbs(shaper.perform(phase), 1e-4));
+    CHECK(shaper.perform(TestType{1}) == shaper.perform(TestType{0}));
+    CHECK(shaper.perform(-std::numeric_limits<TestType>::denorm_min()) == shaper.perform(TestType{0}));
+
+    //A negative phase velocity should choose the same table as a positive one
+    BandLimitedSawShaper<TestType> negativeShaper{};
+    shaper.setPhaseVelocity(TestType{ .1 });
+    negativeShaper.setPhaseVelocity(TestType{ -.1 });
+    CHECK(negativeShaper.perform(phase) == shaper.perform(phase));
+}
+
+//PolyBLEP only corrects the two samples around each discontinuity, so it removes less aliasing than the wavetables,
+// but it should still be a clear improvement on the naive waveforms
+TEMPLATE_TEST_CASE("PolyBLEP Aliasing", "[Oscillator]", float, double) {
+    constexpr auto minimumReduction = TestType{10};
+
+    SECTION("Saw") {
+        checkAliasingReduced<TestType>(std::make_unique<SawShaper<TestType>>(), std::make_unique<PolyBlepSawShaper<TestType>>(), minimumReduction);
+    }
+    SECTION("Square") {
+        checkAliasingReduced<TestType>(std::make_unique<SquareShaper<TestType>>(), std::make_unique<PolyBlepSquareShaper<TestType>>(), minimumReduction);
+    }
+    SECTION("Tri") {
+        checkAliasingReduced<TestType>(std::make_unique<TriShaper<TestType>>(), std::make_unique<PolyBlampTriShaper<TestType>>(), minimumReduction);
+    }
+}
+
+//A negative frequency runs the phase backwards through the same discontinuities,
+// so the corrections have to be the same as they are going forwards
+template<typename ShaperType, typename SampleType>
+void checkNegativeVelocityCorrected(const SampleType& phaseVelocity) {
+    ShaperType forwards{}, backwards{}, naive{};
+    forwards.setPhaseVelocity(phaseVelocity);
+    backwards.setPhaseVelocity(-phaseVelocity);
+
+    size_t numCorrected = 0;
+    for (size_t i = 0; i < 1000; ++i) {
+        const auto phase = static_cast<SampleType>(i)/SampleType{1000};
+        CHECK(backwards.perform(phase) == forwards.perform(phase));
+        numCorrected += forwards.perform(phase) != naive.perform(phase) ? 1 : 0;
+    }
+    //The check means nothing if neither of them corrected anything
+    REQUIRE(numCorrected > 0);
+}
+
+TEMPLATE_TEST_CASE("PolyBLEP Negative Frequency", "[Oscillator]", float, double) {
+    constexpr auto phaseVelocity = TestType{.01};
+
+    checkNegativeVelocityCorrected<PolyBlepSawShaper<TestType>>(phaseVelocity);
+    checkNegativeVelocityCorrected<PolyBlepSquareShaper<TestType>>(phaseVelocity);
+    checkNegativeVelocityCorrected<PolyBlampTriShaper<TestType>>(phaseVelocity);
+}
+
+TEMPLATE_TEST_CASE("Approximate Sin Wave", "[Oscillator]", float, double) {
+    //Check every phase on a fine grid, including the edges of each quarter of the cycle
+    constexpr size_t numPhases = 1 << 16;
+
+    //Compare against a double precision sin, so the reference's own rounding doesn't count against float
+    const auto checkAccuracy = [](auto shaper, const Decibel<TestType>& threshold) {
+        std::vector<TestType> block(numPhases+1);
+        for (size_t i = 0; i < block.size(); ++i)
+            block[i] = std::min(static_cast<TestType>(i)/static_cast<TestType>(numPhases), TestType{1}-std::numeric_limits<TestType>::epsilon()/2);
+
+        const auto phases = block;
+        shaper.process(block.data(), block.size());
+
+        TestType largestError{0};
+        for (size_t i = 0; i < block.size(); ++i) {
+            const auto reference = std::sin(static_cast<double>(phases[i])*juce::MathConstants<double>::twoPi);
+            largestError = std::max(largestError, static_cast<TestType>(std::abs(block[i]-reference)));
+            CHECK(shaper.perform(phases[i]) == block[i]);
+        }
+
+        const Decibel<TestType> errorLevel = Amplitude{largestError};
+        INFO("Largest error: " << errorLevel);
+        CHECK(errorLevel.count() < threshold.count());
+    };
+
+    SECTION("-120dB") {
+        checkAccuracy(SinShaper120dB<TestType>{}, Decibel<TestType>{TestType{-120}});
+    }
+    SECTION("-96dB") {
+        checkAccuracy(SinShaper96dB<TestType>{}, Decibel<TestType>{TestType{-96}});
+    }
+    SECTION("-60dB") {
+        checkAccuracy(SinShaper60dB<TestType>{}, Decibel<TestType>{TestType{-60}});
+    }
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Oscillator.h"
+#include "../Utilities/Lerp.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+// Tagged value for choosing which waveform a set of band-limited wavetables holds
+// i.e. WavetableShaper<float, WavetableWaveform::SawWave>
+enum WavetableWaveform {
+    SawWave, SquareWave, TriWave
+};
+
+//A set of band-limited tables for a waveform, one per octave
+// Each table is built by summing the waveform's harmonics, and each octave holds half as many harmonics as the one below it,
+// so there's always a table whose highest harmonic is below nyquist for the current frequency
+//The tables are built the first time they're used, and then shared by every shaper of the same type
+template<typename SampleType, WavetableWaveform Waveform>
+class BandLimitedWavetables
+{
+public:
+    static constexpr size_t TableSize = 2048;
+    static constexpr size_t NumTables = 10;
+    //Only fill the lower half of the table's bandwidth, so the interpolation between points stays accurate
+    static constexpr size_t MaxHarmonics = TableSize/4;
+
+    static const BandLimitedWavetables& get() {
+        static const BandLimitedWavetables tables{};
+        return tables;
+    }
+
+    //Find the table with the most harmonics that will all be below nyquist at this phase velocity
+    //A negative velocity, like a frequency modulated below 0, aliases just as much as a positive one
+    static constexpr size_t getTableIndex(const SampleType& phaseVelocity) noexcept {
+        const auto speed = phaseVelocity < SampleType{0} ? -phaseVelocity : phaseVelocity;
+        size_t index = 0;
+        while (index < NumTables-1 && speed*static_cast<SampleType>(MaxHarmonics >> index) > SampleType{.5})
+            ++index;
+        return index;
+    }
+
+    //Each table has an extra point at the end that repeats the first, so interpolating past the last point doesn't need to wrap
+    const SampleType* getTable(size_t index) const noexcept {
+        return tables.data()+index*(TableSize+1);
+    }
+
+private:
+    std::vector<SampleType> tables = std::vector<SampleType>(NumTables*(TableSize+1));
+
+    BandLimitedWavetables() {
+        //Look up each harmonic's sin values from a single cycle, rather than calling sin for every harmonic of every point
+        std::vector<double> sinTable(TableSize);
+        for (size_t i = 0; i < TableSize; ++i)
+            sinTable[i] = std::sin(juce::MathConstants<double>::twoPi*static_cast<double>(i)/static_cast<double>(TableSize));
+
+        for (size_t tableIndex = 0; tableIndex < NumTables; ++tableIndex) {
+            auto* table = tables.data()+tableIndex*(TableSize+1);
+            const auto numHarmonics = MaxHarmonics >> tableIndex;
+
+            for (size_t i = 0; i < TableSize; ++i) {
+                double sum = 0.0;
+                for (size_t harmonic = 1; harmonic <= numHarmonics; ++harmonic)
+                    sum += getHarmonicAmplitude(harmonic)*sinTable[(harmonic*i)%TableSize];
+                table[i] = static_cast<SampleType>(sum);
+            }
+
+            table[TableSize] = table[0];
+        }
+    }
+
+    //The fourier series of each waveform, matching the phase and polarity of the naive shapers
+    static double getHarmonicAmplitude(size_t harmonic) noexcept {
+        constexpr auto pi = juce::MathConstants<double>::pi;
+        const auto n = static_cast<double>(harmonic);
+        const auto isOdd = harmonic%2 == 1;
+
+        if constexpr (Waveform == WavetableWaveform::SawWave)
+            return -2.0/(pi*n);
+        else if constexpr (Waveform == WavetableWaveform::SquareWave)
+            return isOdd ? 4.0/(pi*n) : 0.0;
+        else
+            return isOdd ? ((harmonic/2)%2 == 0 ? 8.0 : -8.0)/(pi*pi*n*n) : 0.0;
+    }
+};
+
+//A shaper that reads its waveform from band-limited wavetables,
+// using the oscillator's phase velocity to choose a table that won't alias
+//The table is only chosen when the frequency changes, and each sample is a linear interpolation between two points
+template<typename SampleType, WavetableWaveform Waveform>
+class WavetableShaper : public Shaper<SampleType>
+{
+    using Tables = BandLimitedWavetables<SampleType, Waveform>;
+
+public:
+    //The phase is wrapped into the table, so negative phases and phases of 1 or more read the right point.
+    // Wrapping a tiny negative phase can round up to exactly 1, so the index is clamped to the last point,
+    // and interpolating all the way to the point after it gives the first point again
+    virtual SampleType perform(const SampleType& in) override {
+        const auto position = (in-std::floor(in))*static_cast<SampleType>(Tables::TableSize);
+        const auto index = std::min(static_cast<size_t>(position), Tables::TableSize-1);
+        return lerp(table[index], table[index+1], position-static_cast<SampleType>(index));
+    }
+
+    virtual void process(SampleType* buffer, size_t numSamples) override {
+        for (size_t i = 0; i < numSamples; ++i)
+            buffer[i] = WavetableShaper::perform(buffer[i]);
+    }
+
+    virtual void setPhaseVelocity(const SampleType& newPhaseVelocity) override {
+        table = Tables::get().getTable(Tables::getTableIndex(newPhaseVelocity));
+    }
+
+private:
+    const SampleType* table = Tables::get().getTable(0);
+};
+
+//Band-limited versions of the saw, square, and triangle shapers
+template<typename SampleType>
+using BandLimitedSawShaper = WavetableShaper<SampleType, WavetableWaveform::SawWave>;
+template<typename SampleType>
+using BandLimitedSquareShaper = WavetableShaper<SampleType, WavetableWaveform::SquareWave>;
+template<typename SampleType>
+using BandLimitedTriShaper = WavetableShaper<SampleType, WavetableWaveform::TriWave>;
\ No newline at end of file
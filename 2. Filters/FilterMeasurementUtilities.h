@@ -1,53 +1,150 @@
 #pragma once
 
+#include <algorithm>
+#include <limits>
+#include <utility>
+
 #include "FilterTestUtilities.h"
+#include "Signal Analysis/BiquadResponse.h"
+#include "Signal Analysis/ImpulseResponse.h"
+#include "Signal Analysis/ExponentialSweep.h"
 
-//A variable that hold the number of iterations for the loops where we're
-// measuring things
+//The most samples a tone is run through a filter for when measuring its level,
+// for frequencies so low or filters so slow to settle that the measurement never finishes
 constexpr size_t numMeasurementIterations = 100000;
 
-//Measure the level of a sin wave run through a filter at a certain frequency
-template<typename SampleType, typename Filter>
-auto measureFilteredSinLevelAtFrequency(Filter& filter,
-                                        SampleType testFrequency,
-                                        SampleType sampleRate) {
-    CumulativeAverage<SampleType> outputAverage{};
+//The fewest and most samples a tone's level is measured over at a time
+//Tones with periods longer than the most are measured over part of a period,
+// so even they're measured enough times to tell whether the filter has settled
+constexpr size_t minimumMeasurementLength = 512;
+constexpr size_t maximumMeasurementLength = numMeasurementIterations/4;
 
+//How much two measurements in a row can differ for the filter's transient to count as having died away,
+// relative to the level measured, or to an input at 0dB for levels quieter than -40dB
+template<typename SampleType>
+constexpr auto settledTolerance = SampleType{1e-4};
+template<typename SampleType>
+constexpr auto settledLevelFloor = SampleType{1e-2};
+
+//The quietest level a filter's output can be measured at
+//Roundoff builds up in a filter's state, so anything within a couple of orders of magnitude of the sample type's precision
+// is mostly rounding error, and is read as this level instead
+template<typename SampleType>
+constexpr auto measurementFloor = std::numeric_limits<SampleType>::epsilon()*SampleType{100};
+
+//The level a filter's impulse response has to decay below to count as having died away, which is 120dB below the impulse
+template<typename SampleType>
+constexpr auto impulseDecayThreshold = SampleType{1e-6};
+
+//The band the sweep a filter's response is measured with covers, and how long the response it recovers is
+//The start is in Hz, and the end is a fraction of the sample rate, just below nyquist.
+// The deconvolution's rounding error above the end of a sweep spreads over the whole response, and swamps the quiet parts of it
+//The response has to be long enough for the filters the rolloff is measured on to ring down at the lowest cutoff,
+// which takes a Butterworth filter at 43Hz about 3000 samples.
+//Starting at 40Hz, the sweep can be synchronized in less than 8192 samples, so the sweep and the response fit a 16384 point fft,
+// and the levels it measures are within .05dB of the filters' exact responses down to -100dB
+template<typename SampleType>
+constexpr auto measurementSweepStart = SampleType{40};
+template<typename SampleType>
+constexpr auto measurementSweepEndRatio = SampleType{.499};
+constexpr size_t measurementSweepLength = 1 << 13;
+constexpr size_t measurementResponseLength = 1 << 12;
+
+//Measure the amplitude of a sin wave at a certain frequency after it's been run through a function
+//The output is measured with a Goertzel analyzer a whole number of periods at a time,
+// and measuring stops once two measurements in a row agree, which is when the function's start up transient has died away
+//This takes a few thousand samples for the filters in the tests, where averaging the level took 100000
+template<typename SampleType, typename Function>
+auto measureSettledSinAmplitude(Function&& process, SampleType testFrequency, SampleType sampleRate) {
     Oscillator<SampleType> sinWave;
     sinWave.setSampleRate(sampleRate);
     sinWave.setFrequency(testFrequency);
     sinWave.setWaveform(std::make_unique<SinShaper<SampleType>>());
 
-    filter.reset();
+    GoertzelAnalyzer<SampleType> analyzer{};
+    analyzer.setFrequency(testFrequency, sampleRate);
+    const auto length = GoertzelAnalyzer<SampleType>::getWholePeriodLength(testFrequency, sampleRate,
+                                                                           minimumMeasurementLength,
+                                                                           maximumMeasurementLength);
 
+    auto amplitude = SampleType{0};
+    for (size_t numSamples = 0; numSamples+length <= numMeasurementIterations; numSamples += length) {
+        analyzer.reset();
+        for (size_t i = 0; i < length; ++i)
+            analyzer.update(process(sinWave.perform()));
 
-    for (auto i = 0; i < numMeasurementIterations; ++i) {
-        const auto filteredVal = filter.processSample(sinWave.perform());
-        outputAverage.updateAverage(std::abs(filteredVal));
+        const auto previousAmplitude = std::exchange(amplitude, analyzer.getAmplitude());
+        if (numSamples > 0
+            && std::abs(amplitude-previousAmplitude) <= settledTolerance<SampleType>*std::max(amplitude, settledLevelFloor<SampleType>))
+            break;
     }
-    return outputAverage;
+    return std::max(amplitude, measurementFloor<SampleType>);
+}
+
+//Measure the level of a sin wave run through a filter at a certain frequency
+template<typename SampleType, typename Filter>
+auto measureFilteredSinLevelAtFrequency(Filter& filter,
+                                        SampleType testFrequency,
+                                        SampleType sampleRate) {
+    filter.reset();
+    return measureSettledSinAmplitude([&](const auto& sample) { return filter.processSample(sample); },
+                                      testFrequency, sampleRate);
 }
 
-//Get the spectrum of white noise through a filter
+//Get the spectrum of white noise through a filter, from the noise's own spectrum and the filter's impulse response
+//Each bin of the noise's spectrum is multiplied by the filter's response at that bin.
+// That's exact and the same every run for linear, time invariant filters like JUCE's IIR filters,
+// and only runs the filter for as long as it rings
+//The noise's spectrum sets the size of the spectrum, so it has to be the one measured with the size of spectrum being checked
 template<typename SampleType,
-         size_t FFTSize,
-         typename NoiseBuffer,
+         typename NoiseSpectrum,
          typename Filter>
-auto getFilteredSpectrum(FFTHelper<FFTSize>& fft,
-                         const NoiseBuffer& noiseBuffer,
+auto getFilteredSpectrum(const NoiseSpectrum& noiseSpectrum,
                          Filter& filter)
 {
-    BufferAverager<SampleType, FFTSize*2> accumulator{};
+    const auto impulseResponse = measureImpulseResponse(filter, numMeasurementIterations, impulseDecayThreshold<SampleType>);
+    const auto response = getImpulseResponseSpectrum<SampleType>(impulseResponse, noiseSpectrum.size()*2);
+
+    AlignedVector<SampleType> levels(noiseSpectrum.size());
+    for (size_t i = 0; i < levels.size(); ++i)
+        levels[i] = response.magnitudes[i]*noiseSpectrum[i];
+    return levels;
+}
 
-    fft.reset();
+//Run an exponential sweep through a filter, followed by responseLength samples of silence for its tail,
+// and recover the filter's impulse response, and the responses of any harmonics it adds, from that single render
+//The whole band the sweep covers is measured at once, where measuring the level of sin waves takes a render for each frequency
+template<typename SampleType, typename Filter>
+auto measureSweepResponse(Filter& filter,
+                          const ExponentialSweep<SampleType>& sweep,
+                          size_t responseLength,
+                          size_t numHarmonics = 0)
+{
     filter.reset();
 
-    for(auto&& sample : noiseBuffer) {
-        const auto result = fft.perform(static_cast<float>(filter.processSample(sample)));
-        if (result != std::nullopt)
-            accumulator.perform(result.value());
-    }
-    return accumulator.getBuffer();
+    AlignedVector<SampleType> recording(sweep.getNumSamples()+responseLength);
+    std::transform(sweep.getSignal().begin(), sweep.getSignal().end(), recording.begin(),
+                   [&](const auto& sample) { return filter.processSample(sample); });
+    std::generate(recording.begin()+sweep.getNumSamples(), recording.end(),
+                  [&] { return filter.processSample(SampleType{0}); });
+
+    return sweep.deconvolve(recording, responseLength, numHarmonics);
+}
+
+//Measure a filter's impulse response with the measurement sweep, so its level at any frequency inside it can be read off
+//The sweep comes from the cache, so it's only rendered and inverted once for each sample rate
+template<typename SampleType, typename Filter>
+auto measureSweptImpulseResponse(Filter& filter, SampleType sampleRate) {
+    const auto sweep = ExponentialSweepCache<SampleType>::getSweep(measurementSweepStart<SampleType>,
+                                                                    measurementSweepEndRatio<SampleType>*sampleRate,
+                                                                    measurementSweepLength, sampleRate, measurementResponseLength);
+    return measureSweepResponse(filter, *sweep, measurementResponseLength).linear;
+}
+
+//Get the amplitude of a sin wave at a given frequency and samplerate
+template<typename T>
+auto getSinAmplitude(T frequency, T sampleRate) {
+    return measureSettledSinAmplitude([](const auto& sample) { return sample; }, frequency, sampleRate);
 }
 
 //Calculates the difference in level of a sin wave before and after filtering
@@ -56,48 +153,25 @@ auto calculateLevelReductionAtFrequency(Filter& filter,
                                         const Frequency<SampleType>& frequency,
                                         SampleType sampleRate)
 {
-    CumulativeAverage<SampleType> sinAverage{};
-    CumulativeAverage<SampleType> filterAverage{};
-
-    Oscillator<SampleType> sinWave;
-    sinWave.setSampleRate(sampleRate);
-    sinWave.setFrequency(frequency);
-    sinWave.setWaveform(std::make_unique<SinShaper<SampleType>>());
-
-    filter.reset();
-
-    for (auto i = 0; i < numMeasurementIterations; ++i) {
-        const auto sinVal = sinWave.perform();
-        sinAverage.updateAverage(std::abs(sinVal));
-        filterAverage.updateAverage(std::abs(filter.processSample(sinVal)));
-    }
-
-    const Decibel<SampleType> peakSinLevel    = Amplitude(sinAverage.getAverage());
-    const Decibel<SampleType> peakFilterLevel = Amplitude(filterAverage.getAverage());
+    const Decibel<SampleType> peakSinLevel    = Amplitude(getSinAmplitude(frequency.count(), sampleRate));
+    const Decibel<SampleType> peakFilterLevel = Amplitude(measureFilteredSinLevelAtFrequency(filter, frequency.count(), sampleRate));
     const auto decibelValue = peakSinLevel.count()-peakFilterLevel.count();
     const auto sign = std::signbit(decibelValue) ? 1.0 : -1.0;
     return Decibel{sign*std::abs(decibelValue)};
 }
 
-//Get the average absolute amplitude of a sin wave
-// at a given frequency and samplerate
-template<typename T>
-auto getSinAverage(T frequency, T sampleRate) {
-    //Make a sine wave oscillator
-    Oscillator<T> sinWave;
-    sinWave.setSampleRate(sampleRate);
-    sinWave.setFrequency(frequency);
-    sinWave.setWaveform(std::make_unique<SinShaper<T>>());
-
-    //Make an averager to measure the value
-    CumulativeAverage<T> sinAverage{};
-
-    for (auto i = 0; i < numMeasurementIterations; ++i) {
-        const auto sinVal = sinWave.perform();
-        sinAverage.updateAverage(std::abs(sinVal));
-    }
+//Works out the difference in level of a sin wave before and after filtering from the filter's coefficients
+//This is exact and takes no time, so a test can check it before measuring the filter
+template<typename SampleType, typename Filter>
+auto calculateAnalyticLevelReductionAtFrequency(const Filter& filter,
+                                                const Frequency<SampleType>& frequency,
+                                                SampleType sampleRate)
+{
+    const auto magnitude = BiquadResponse<SampleType>::fromFilter(filter).getMagnitude(frequency.count(), sampleRate);
+    const Decibel<SampleType> level = Amplitude(std::max(magnitude, measurementFloor<SampleType>));
 
-    return sinAverage;
+    //Return the same type calculateLevelReductionAtFrequency does, so the two can be checked the same way
+    return Decibel{static_cast<double>(level.count())};
 }
 
 // Tagged Value for setting the behavior of testRolloffCharacteristics
@@ -108,7 +182,8 @@ enum RolloffDirection {
     Up, Down
 };
 
-//Tests the level of a sin wave through a filter at different octaves
+//Tests the level of a filter at different octaves
+//The whole response is measured with a single sweep, and the level of each octave is read off of it
 //The test passes if the difference in level between octaves matches rolloff, within the tolerance
 template<RolloffDirection Direction, typename Filter, typename T>
 void testRolloffCharacteristics(Filter& filter,
@@ -128,12 +203,14 @@ void testRolloffCharacteristics(Filter& filter,
     // nyquist/2
     const auto numOctaves = static_cast<size_t>(std::ceil(std::log(sampleRate/T{2})/std::log(cutoff.count())/std::log(2.0)));
 
+    const auto impulseResponse = measureSweptImpulseResponse(filter, sampleRate);
+
     for(auto i = 0; i < numOctaves; ++i) {
-        //Get the desired frequency value of the first octave, clamping it if it gets too high
-        const auto boundedFrequency = AnalogFrequency<T>{DigitalFrequency<T>{std::min(sampleRate / T{8},
-                                                                                       std::pow(octaveScalar,
-                                                                                                T(i) * cutoff.count())
-                                                                                       ),
+        //Get the desired frequency value of the first octave, clamping it if it gets too high,
+        // or so low that the octave below it starts before the sweep
+        const auto boundedFrequency = AnalogFrequency<T>{DigitalFrequency<T>{std::clamp(cutoff.count()*std::pow(octaveScalar, T(i)),
+                                                                                         measurementSweepStart<T>*T{2},
+                                                                                         sampleRate / T{8}),
                                                                               sampleRate},
                                                          sampleRate};
 
@@ -141,12 +218,14 @@ void testRolloffCharacteristics(Filter& filter,
         const auto lowFrequency = DigitalFrequency{ boundedFrequency / T{2},
                                            sampleRate };
 
-        //Get the average level of the first octave
+        //Get the level of the first octave
         const Decibel<T> currentCutoffAverage
-                = Amplitude<T>(measureFilteredSinLevelAtFrequency(filter, boundedFrequency.count(), sampleRate).getAverage());
-        //Get the average level of the second octave
+                = Amplitude<T>(std::max(getImpulseResponseMagnitude(impulseResponse, boundedFrequency.count(), sampleRate),
+                                        measurementFloor<T>));
+        //Get the level of the second octave
         const Decibel<T> nextCutoffAverage
-                = Amplitude<T>(measureFilteredSinLevelAtFrequency(filter, lowFrequency.count(), sampleRate).getAverage());
+                = Amplitude<T>(std::max(getImpulseResponseMagnitude(impulseResponse, lowFrequency.count(), sampleRate),
+                                        measurementFloor<T>));
         //Check that the second octave plus the rolloff and threshold is higher than the current octave
         //Meaning that, when correcting for rolloff, the two octaves are within the tolerance level of each other
         REQUIRE(nextCutoffAverage.count()
@@ -1,35 +1,67 @@
 #pragma once
 
 #include "Signal Analysis/Signal Analyzers.h"
+#include "Signal Analysis/FFT/WelchSpectrum.h"
+#include "NoiseCache.h"
+
+#include "../Utilities/Random.h"
 
 #include "../1. Oscillator/Oscillator.h"
 
 // Makes and returns a container of white noise samples
 // Using vector so that very large buffers don't cause a stack overflow
+// The noise only depends on the seed, so the same buffer can be made again from the seed alone
 template<typename SampleType, size_t NumSamples>
-auto makeNoiseBuffer() {
+auto makeNoiseBuffer(uint64_t seed) {
     std::vector<SampleType> vec;
     vec.resize(NumSamples);
-    std::generate(vec.begin(), vec.end(), []() {return getBoundedRandom(SampleType{ -1 }, SampleType{ 1 });});
+    Philox{seed}.fill(vec, SampleType{ -1 }, SampleType{ 1 });
     return vec;
 }
 
-//Generate a spectrum from a buffer
+//How accurately the noise spectra are estimated, as the standard deviation of each bin's power relative to the power
+//This keeps each bin's level within about .4dB, which is well inside the tolerances the filter tests use
+template<typename SampleType>
+constexpr auto spectrumRelativeError = SampleType{.1};
+
+//Push a buffer through a function and into a Welch spectrum a hop at a time,
+// stopping as soon as the spectrum's estimate is accurate enough, or the buffer runs out
+//Every spectrum made this way stops after the same number of samples, so spectra of the same noise line up
+template<typename Spectrum, typename Buffer, typename Function>
+void estimateSpectrum(Spectrum& spectrum, const Buffer& buffer, Function&& process) {
+    using SampleType = typename Buffer::value_type;
+    constexpr auto blockSize = Spectrum::NumBins;
+
+    std::array<SampleType, blockSize> block{};
+    for (size_t start = 0;
+         start < buffer.size() && spectrum.getRelativeError() > spectrumRelativeError<SampleType>;
+         start += blockSize) {
+        const auto numSamples = std::min(blockSize, buffer.size()-start);
+        std::transform(buffer.begin()+start, buffer.begin()+start+numSamples, block.begin(), process);
+        spectrum.pushBlock(block.data(), numSamples);
+    }
+}
+
+//The settings the filter tests estimate spectra with, which the noise cache keeps with each spectrum it stores
+//The filtered spectra are compared against the noise's, so they're estimated the same way, with a default WelchSpectrum
+template<typename SampleType, size_t FFTSize>
+constexpr auto getNoiseSpectrumSettings() noexcept {
+    using Spectrum = WelchSpectrum<FFTSize, SampleType>;
+    return NoiseSpectrumSettings{Spectrum::DefaultHopSize, static_cast<uint32_t>(Spectrum::DefaultWindow),
+                                 static_cast<double>(spectrumRelativeError<SampleType>)};
+}
+
+//Generate a spectrum from a buffer, with the level of each bin below nyquist
 template<typename SampleType, size_t FFTSize, typename T>
 auto makeSpectrum(const T& noiseBuffer) {
-    BufferAverager<SampleType, FFTSize * 2> accumulator{};
-    FFTHelper<FFTSize> fft{};
-    for (auto &&sample : noiseBuffer) {
-        const auto result = fft.perform(static_cast<float>(sample));
-        if (result != std::nullopt)
-            accumulator.perform(result.value());
-    }
-    return accumulator.getBuffer();
+    WelchSpectrum<FFTSize, SampleType> spectrum{};
+    estimateSpectrum(spectrum, noiseBuffer, [](const auto& sample) { return sample; });
+    return spectrum.getLevelSpectrum();
 }
 
 template<typename T, size_t BufferSize, size_t SpectrumSize>
-auto makeNoiseBufferAndSpectrum() {
-    const auto buffer = makeNoiseBuffer<T, BufferSize>();
+auto makeNoiseBufferAndSpectrum(uint64_t seed) {
+    const auto buffer = makeNoiseBuffer<T, BufferSize>(seed);
     const auto spectrum = makeSpectrum<T, SpectrumSize>(buffer);
     return std::pair{buffer, spectrum};
 }
@@ -38,17 +70,26 @@ auto makeNoiseBufferAndSpectrum() {
 //Making these is time intensive, the tests take too long as is,
 // semantically one buffer/spectrum of noise is equivalent to another,
 // so this lets the filter test context cache a set based on type
+//The set is kept in a file that every test process shares, so it's only made once, rather than once for each test case CTest runs
 template<typename SampleType>
 struct NoiseContext
 {
 private:
+    //A 1024 point spectrum with 50% overlap reaches spectrumRelativeError after about 55000 samples
+    static constexpr size_t NumSamples = 60000;
+    static constexpr size_t FFTSize = 1024;
+    //The noise is always generated from the same seed, so the file is the same whichever process makes it
+    static constexpr uint64_t Seed = 1;
+
     //Initialize the buffer and spectrum together in a single function to prevent static order initialization fiasco
-    static const inline auto vars = makeNoiseBufferAndSpectrum<SampleType, 100000, 1024>();
+    static const inline auto cache = NoiseCache<SampleType>{NoiseCache<SampleType>::getFile(NumSamples, FFTSize, Seed, getNoiseSpectrumSettings<SampleType, FFTSize>()),
+                                                            NumSamples, FFTSize/2, Seed, getNoiseSpectrumSettings<SampleType, FFTSize>(),
+                                                            [] { return makeNoiseBufferAndSpectrum<SampleType, NumSamples, FFTSize>(Seed); }};
 
 public:
     //Provide references to the buffer and spectrum
-    static const auto& getBuffer()   noexcept { return vars.first; }
-    static const auto& getSpectrum() noexcept { return vars.second; }
+    static const auto& getBuffer()   noexcept { return cache.getBuffer(); }
+    static const auto& getSpectrum() noexcept { return cache.getSpectrum(); }
 };
 
 template<typename FFTSize, typename FilterType, typename T>
@@ -77,9 +118,6 @@ public:
             NoiseContext<SampleType>::getBuffer();
     const static inline auto& noiseSpectrum =
             NoiseContext<SampleType>::getSpectrum();
-
-// Don't make this static as it will cause thread safety issues w/ Ctest
-    FFTHelper<FFTSize::value> fft{};
 };
 
 
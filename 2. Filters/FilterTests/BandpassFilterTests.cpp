@@ -23,13 +23,12 @@ TEMPLATE_TEST_CASE("Bandpass Filter Spectrum Shape", "[Bandpass Filter] "
 
     const auto warpedCutoffBinIndex = (warpedCutoff.count() / testContext.sampleRate) * FFTSize;
 
-    const auto filterSpectrum = getFilteredSpectrum<SampleType>(testContext.fft,
-                                                                testContext.noiseBuffer,
+    const auto filterSpectrum = getFilteredSpectrum<SampleType>(testContext.noiseSpectrum,
                                                                 testContext.filter);
 
     for (size_t i = 0; i < FFTSize/2; ++i) {
-        const Decibel<SampleType> noiseLevel    = Amplitude{testContext.noiseSpectrum[i].getAverage()};
-        const Decibel<SampleType> filteredLevel = Amplitude{filterSpectrum[i].getAverage()};
+        const Decibel<SampleType> noiseLevel    = Amplitude{testContext.noiseSpectrum[i]};
+        const Decibel<SampleType> filteredLevel = Amplitude{filterSpectrum[i]};
 
         const auto outputSameOrQuieter = isSameOr<GainChange::Quieter>(noiseLevel,
                                                                        filteredLevel,
@@ -41,8 +40,8 @@ TEMPLATE_TEST_CASE("Bandpass Filter Spectrum Shape", "[Bandpass Filter] "
         REQUIRE((outputSameOrQuieter || differenceVeryQuiet));
 
         if (i > 0) {
-            const Decibel<SampleType> currentBinLevel  = Amplitude{filterSpectrum[i].getAverage()};
-            const Decibel<SampleType> previousBinLevel = Amplitude{filterSpectrum[i - 1].getAverage()};
+            const Decibel<SampleType> currentBinLevel  = Amplitude{filterSpectrum[i]};
+            const Decibel<SampleType> previousBinLevel = Amplitude{filterSpectrum[i - 1]};
 
             const auto binDifferenceVeryQuiet = ResidualDecibels<SampleType>(currentBinLevel,
                                                                              Decibel{SampleType{-120}})
@@ -77,6 +76,12 @@ TEMPLATE_TEST_CASE("Bandpass Filter Cutoff Gain", "[Bandpass Filter] "
     // this represents the actual cutoff frequency of our filter
     const auto warpedCutoff = DigitalFrequency{testContext.cutoff};
 
+    //Check the level worked out from the filter's coefficients first, which is exact, and fails without running the filter
+    REQUIRE_THAT(calculateAnalyticLevelReductionAtFrequency<SampleType>(testContext.filter,
+                                                                        warpedCutoff.count(),
+                                                                        testContext.sampleRate),
+                 WithinDecibels(Decibel{SampleType{0}}, Decibel{SampleType{.5}}));
+
     // Measure the gain difference of sin wave with the same frequency as the warped cutoff
     // input and output from the filter
     //Check that it's within half a dB of a 3dB reduction
@@ -14,16 +14,23 @@ TEMPLATE_TEST_CASE("LowShelf Filter Shape", "[LowShelf Filter] [Filter]",
 
     constexpr auto FFTSize = testContext.SpectrumSize/2;
 
-    const auto filterSpectrum = getFilteredSpectrum<SampleType>(testContext.fft,
-                                                                testContext.noiseBuffer,
+    const auto filterSpectrum = getFilteredSpectrum<SampleType>(testContext.noiseSpectrum,
                                                                 testContext.filter);
 
-    for (size_t i = 1; i < FFTSize; ++i) {
+    //The bilinear transform squeezes the whole response above the cutoff into the bins just below nyquist,
+    // so when the cutoff is in the last few bins, a cut can rise by more than the tolerance from one of those bins to the next,
+    // e.g. a cutoff in bin 509 with a gain of .29 rises by 5.2dB into bin 510
+    //Those bins each cover too much of the response to say anything about its shape, so they're only skipped for those cutoffs
+    constexpr size_t numBinsNearNyquist = 4;
+    const auto cutoffBin = static_cast<size_t>(testContext.cutoff/testContext.sampleRate*static_cast<SampleType>(FFTSize));
+    const auto numBinsChecked = cutoffBin+numBinsNearNyquist >= FFTSize/2 ? FFTSize/2-numBinsNearNyquist : FFTSize/2;
+
+    for (size_t i = 1; i < numBinsChecked; ++i) {
         //After the first bin:
         //Check that the current bin is either the same level or quieter than the previous
         //Or that the difference between them is below the threshold of hearing
-        const Decibel<SampleType> currentBinLevel  = Amplitude{filterSpectrum[i].getAverage()};
-        const Decibel<SampleType> previousBinLevel = Amplitude{filterSpectrum[i-1].getAverage()};
+        const Decibel<SampleType> currentBinLevel  = Amplitude{filterSpectrum[i]};
+        const Decibel<SampleType> previousBinLevel = Amplitude{filterSpectrum[i-1]};
 
         const auto outputSameOrQuieter = isSameOr<GainChange::Quieter>(currentBinLevel,
                                                                        previousBinLevel,
@@ -48,6 +55,12 @@ TEMPLATE_TEST_CASE("LowShelf Filter Gain", "[LowShelf Filter] [Filter]",
     const auto warpedCutoff = DigitalFrequency{testContext.cutoff};
 
     if(testContext.cutoff < testContext.sampleRate/4.0) {
+        //Check the level worked out from the filter's coefficients first, which is exact, and fails without running the filter
+        REQUIRE_THAT(calculateAnalyticLevelReductionAtFrequency<SampleType>(testContext.filter,
+                                                                            warpedCutoff.count(),
+                                                                            testContext.sampleRate),
+                     WithinDecibels(Decibel{ Amplitude{std::sqrt(testContext.filterGain)} }, Decibel{ SampleType{.75} }));
+
         const auto levelDifference = calculateLevelReductionAtFrequency<SampleType>(testContext.filter,
                                                                                     warpedCutoff.count(),
                                                                                     testContext.sampleRate);
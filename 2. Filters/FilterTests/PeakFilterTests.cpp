@@ -31,14 +31,13 @@ TEMPLATE_TEST_CASE("Peak Filter Spectrum Shape", "[Peak Filter] [Filter]",
     const auto warpedCutoffBinIndex = (warpedCutoff.count() / testContext.sampleRate) * FFTSize;
 
     // Get the spectrum of the filtered output
-    const auto filterSpectrum = getFilteredSpectrum<SampleType>(testContext.fft,
-                                                                testContext.noiseBuffer,
+    const auto filterSpectrum = getFilteredSpectrum<SampleType>(testContext.noiseSpectrum,
                                                                 testContext.filter);
 
     //For every bin between 0hz and nyquist, check if the
     for (size_t i = 0; i < FFTSize/2; ++i) {
-        const Decibel<SampleType> noiseLevel    = Amplitude{testContext.noiseSpectrum[i].getAverage()};
-        const Decibel<SampleType> filteredLevel = Amplitude{filterSpectrum[i].getAverage()};
+        const Decibel<SampleType> noiseLevel    = Amplitude{testContext.noiseSpectrum[i]};
+        const Decibel<SampleType> filteredLevel = Amplitude{filterSpectrum[i]};
 
         // Check if the input is the same or quieter than the output
         const auto outputSameOrQuieter = isSameOr<GainChange::Quieter>(noiseLevel,
@@ -60,8 +59,8 @@ TEMPLATE_TEST_CASE("Peak Filter Spectrum Shape", "[Peak Filter] [Filter]",
 
 
         if (i > 0) {
-            const Decibel<SampleType> currentBinLevel  = Amplitude{filterSpectrum[i].getAverage()};
-            const Decibel<SampleType> previousBinLevel = Amplitude{filterSpectrum[i - 1].getAverage()};
+            const Decibel<SampleType> currentBinLevel  = Amplitude{filterSpectrum[i]};
+            const Decibel<SampleType> previousBinLevel = Amplitude{filterSpectrum[i - 1]};
 
             const auto binDifferenceVeryQuiet = ResidualDecibels<SampleType>(currentBinLevel,
                                                                              Decibel{SampleType{-120}})
@@ -103,6 +102,13 @@ TEMPLATE_TEST_CASE("Peak Filter Cutoff Gain", "[Peak Filter] [Filter]",
     //Get the warped frequency of the filter cutoff
     const auto warpedCutoff  = DigitalFrequency{testContext.cutoff};
 
+    //Check the level worked out from the filter's coefficients first, which is exact, and fails without running the filter
+    REQUIRE_THAT(calculateAnalyticLevelReductionAtFrequency<SampleType>(testContext.filter,
+                                                                        warpedCutoff.count(),
+                                                                        testContext.sampleRate),
+                 WithinDecibels(Decibel{Amplitude{testContext.filterGain}},
+                                        Decibel{ SampleType{.5}}));
+
     //Get the difference in level between the input and the output
     const auto levelDifference
         = calculateLevelReductionAtFrequency<SampleType>(testContext.filter,
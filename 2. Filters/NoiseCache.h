@@ -0,0 +1,175 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <juce_core/juce_core.h>
+
+#include "../Utilities/AlignedAllocator.h"
+
+//Change this whenever the way the noise or its spectrum is made changes, so files made the old way aren't read
+//The settings the spectrum is estimated with are checked separately, so changing those doesn't need a new version
+constexpr uint32_t noiseCacheVersion = 3;
+
+//The settings a noise spectrum was estimated with
+//These are part of a noise cache file's header and name, so a spectrum estimated with different settings is never read back
+struct NoiseSpectrumSettings
+{
+    uint64_t hopSize{0};
+    uint32_t window{0};
+    //How accurate the estimate of each bin's power was made, relative to the power
+    double relativeError{0.0};
+};
+
+//A read only view of an array that's owned by something else, like a memory mapped file
+//It has the parts of a vector's interface the filter tests use, so it can be passed anywhere they'd take one
+template<typename T>
+class ArrayView
+{
+public:
+    using value_type = T;
+
+    constexpr ArrayView() noexcept = default;
+    constexpr ArrayView(const T* newData, size_t newSize) noexcept : first(newData), numElements(newSize) {}
+
+    constexpr const T* data()  const noexcept { return first; }
+    constexpr size_t   size()  const noexcept { return numElements; }
+    constexpr const T* begin() const noexcept { return first; }
+    constexpr const T* end()   const noexcept { return first+numElements; }
+
+    constexpr const T& operator[](size_t index) const noexcept { return first[index]; }
+
+private:
+    const T* first{nullptr};
+    size_t numElements{0};
+};
+
+//The start of a noise cache file, which has to match what's expected byte for byte for the file to be used
+//It's padded out to a cache line with zeros, so the samples after it are as aligned as the buffers they'd otherwise be in
+struct NoiseCacheHeader
+{
+    std::array<char, 8> tag{'N', 'O', 'I', 'S', 'E', 'B', 'U', 'F'};
+    uint32_t version{noiseCacheVersion};
+    uint32_t sampleSize{0};
+    uint64_t numSamples{0}, numBins{0}, seed{0};
+    uint64_t hopSize{0};
+    double relativeError{0.0};
+    uint32_t window{0};
+    std::array<char, 4> padding{};
+};
+
+static_assert(sizeof(NoiseCacheHeader) == 64, "The noise cache header shouldn't have any padding the compiler adds");
+
+//A buffer of noise and its spectrum that's generated once, and then shared between every test process through a file
+//CTest runs every test case in its own process, so without this each of them would generate the same noise again
+//The first process to need the noise generates it and writes it to a temporary file, which is renamed into place.
+// The rename is atomic, so processes running at the same time never see a half written file,
+// and two processes generating the noise at once just replace one complete file with another
+//Every other process maps the file read only, so loading the noise is a page fault, and every process shares the same pages
+//If the file can't be read or written, the noise generated in this process is used instead
+template<typename SampleType>
+class NoiseCache
+{
+public:
+    //Generate is called when there's no usable file, and returns the noise buffer and spectrum as a pair
+    template<typename Generate>
+    NoiseCache(const juce::File& file, size_t numSamples, size_t numBins, uint64_t seed,
+               const NoiseSpectrumSettings& settings, Generate&& generate) {
+        expectedHeader.sampleSize    = sizeof(SampleType);
+        expectedHeader.numSamples    = numSamples;
+        expectedHeader.numBins       = numBins;
+        expectedHeader.seed          = seed;
+        expectedHeader.hopSize       = settings.hopSize;
+        expectedHeader.relativeError = settings.relativeError;
+        expectedHeader.window        = settings.window;
+
+        if (map(file))
+            return;
+
+        std::tie(generatedBuffer, generatedSpectrum) = generate();
+        buffer   = ArrayView<SampleType>{generatedBuffer.data(), generatedBuffer.size()};
+        spectrum = ArrayView<SampleType>{generatedSpectrum.data(), generatedSpectrum.size()};
+        write(file);
+    }
+
+    //The buffer and spectrum may point into this cache's own vectors, so it can't be copied
+    NoiseCache(const NoiseCache&) = delete;
+    NoiseCache& operator=(const NoiseCache&) = delete;
+
+    const auto& getBuffer()   const noexcept { return buffer; }
+    const auto& getSpectrum() const noexcept { return spectrum; }
+
+    //Whether the noise was read from the file, rather than generated by this process
+    bool isMapped() const noexcept { return mappedFile != nullptr; }
+
+    //The file the noise for a type, length, fft size, seed and spectrum settings is kept in
+    //The key is part of the name, so noise made with different settings is kept in different files
+    static juce::File getFile(size_t numSamples, size_t fftSize, uint64_t seed, const NoiseSpectrumSettings& settings) {
+        const auto directory = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("FilterTestNoise");
+        directory.createDirectory();
+
+        const auto typeName = std::string{std::is_same_v<SampleType, float> ? "float" : "double"};
+        return directory.getChildFile(juce::String{"noise_v" + std::to_string(noiseCacheVersion)
+                                                   + "_" + typeName
+                                                   + "_" + std::to_string(numSamples)
+                                                   + "_" + std::to_string(fftSize)
+                                                   + "_" + std::to_string(seed)
+                                                   + "_hop" + std::to_string(settings.hopSize)
+                                                   + "_window" + std::to_string(settings.window)
+                                                   + "_error" + std::to_string(settings.relativeError) + ".bin"});
+    }
+
+private:
+    NoiseCacheHeader expectedHeader{};
+
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile{};
+    std::vector<SampleType> generatedBuffer{};
+    AlignedVector<SampleType> generatedSpectrum{};
+
+    ArrayView<SampleType> buffer{}, spectrum{};
+
+    size_t getFileSize() const noexcept {
+        return sizeof(NoiseCacheHeader)+(expectedHeader.numSamples+expectedHeader.numBins)*sizeof(SampleType);
+    }
+
+    //Point the buffer and spectrum at the file, if it exists and was made with the same settings
+    bool map(const juce::File& file) {
+        if (!file.existsAsFile())
+            return false;
+
+        auto newFile = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+        if (newFile->getData() == nullptr
+            || newFile->getSize() != getFileSize()
+            || std::memcmp(newFile->getData(), &expectedHeader, sizeof(NoiseCacheHeader)) != 0)
+            return false;
+
+        const auto* samples = reinterpret_cast<const SampleType*>(static_cast<const char*>(newFile->getData())+sizeof(NoiseCacheHeader));
+        buffer   = ArrayView<SampleType>{samples, expectedHeader.numSamples};
+        spectrum = ArrayView<SampleType>{samples+expectedHeader.numSamples, expectedHeader.numBins};
+        mappedFile = std::move(newFile);
+        return true;
+    }
+
+    //Write the noise to a temporary file, and move it into place once it's complete
+    void write(const juce::File& file) const {
+        if (generatedBuffer.size() != expectedHeader.numSamples || generatedSpectrum.size() != expectedHeader.numBins)
+            return;
+
+        const juce::TemporaryFile temporaryFile{file};
+        {
+            juce::FileOutputStream stream{temporaryFile.getFile()};
+            if (!stream.openedOk()
+                || !stream.write(&expectedHeader, sizeof(NoiseCacheHeader))
+                || !stream.write(generatedBuffer.data(), generatedBuffer.size()*sizeof(SampleType))
+                || !stream.write(generatedSpectrum.data(), generatedSpectrum.size()*sizeof(SampleType)))
+                return;
+            stream.flush();
+        }
+        temporaryFile.overwriteTargetFileWithTemporary();
+    }
+};
@@ -0,0 +1,109 @@
+#include <catch2/catch.hpp>
+
+#include "NoiseCache.h"
+
+#include <numeric>
+
+constexpr NoiseSpectrumSettings testSettings{512, 0, .1};
+
+//Make a buffer and spectrum that are easy to check, and count how many times they're made
+template<typename SampleType>
+auto makeCountingGenerator(size_t numSamples, size_t numBins, size_t& numCalls) {
+    return [numSamples, numBins, &numCalls] {
+        ++numCalls;
+        std::vector<SampleType> buffer(numSamples);
+        AlignedVector<SampleType> spectrum(numBins);
+        std::iota(buffer.begin(), buffer.end(), SampleType{0});
+        std::iota(spectrum.begin(), spectrum.end(), SampleType{-1});
+        return std::pair{buffer, spectrum};
+    };
+}
+
+template<typename SampleType, typename Cache>
+void checkContents(const Cache& cache, size_t numSamples, size_t numBins) {
+    REQUIRE(cache.getBuffer().size() == numSamples);
+    REQUIRE(cache.getSpectrum().size() == numBins);
+    for (size_t i = 0; i < numSamples; ++i)
+        REQUIRE(cache.getBuffer()[i] == static_cast<SampleType>(i));
+    for (size_t i = 0; i < numBins; ++i)
+        REQUIRE(cache.getSpectrum()[i] == static_cast<SampleType>(i)-SampleType{1});
+}
+
+//Test that the noise is generated the first time, and read back from the file after that
+TEMPLATE_TEST_CASE ("Noise Cache Reuses File", "[Noise Cache]", float, double)
+{
+    constexpr size_t numSamples = 1000, numBins = 64;
+    const auto file = NoiseCache<TestType>::getFile(numSamples, numBins*2, 12345, testSettings);
+    file.deleteFile();
+
+    size_t numCalls = 0;
+    {
+        const NoiseCache<TestType> cache{file, numSamples, numBins, 12345, testSettings, makeCountingGenerator<TestType>(numSamples, numBins, numCalls)};
+        REQUIRE(numCalls == 1);
+        REQUIRE_FALSE(cache.isMapped());
+        checkContents<TestType>(cache, numSamples, numBins);
+    }
+
+    REQUIRE(file.existsAsFile());
+    const NoiseCache<TestType> cache{file, numSamples, numBins, 12345, testSettings, makeCountingGenerator<TestType>(numSamples, numBins, numCalls)};
+    REQUIRE(numCalls == 1);
+    REQUIRE(cache.isMapped());
+    checkContents<TestType>(cache, numSamples, numBins);
+
+    //The samples after the header keep the alignment the in memory buffers have
+    REQUIRE(reinterpret_cast<uintptr_t>(cache.getBuffer().data())%64 == 0);
+
+    file.deleteFile();
+}
+
+//Test that a file made with different settings, or cut short, isn't read, and is replaced
+TEST_CASE ("Noise Cache Rejects Mismatched Files", "[Noise Cache]")
+{
+    constexpr size_t numSamples = 1000, numBins = 64;
+    const auto file = NoiseCache<float>::getFile(numSamples, numBins*2, 54321, testSettings);
+    file.deleteFile();
+
+    size_t numCalls = 0;
+    {
+        //Write a file with a different seed, then ask for the same file with the right one
+        const NoiseCache<float> cache{file, numSamples, numBins, 1, testSettings, makeCountingGenerator<float>(numSamples, numBins, numCalls)};
+    }
+    {
+        const NoiseCache<float> cache{file, numSamples, numBins, 54321, testSettings, makeCountingGenerator<float>(numSamples, numBins, numCalls)};
+        REQUIRE(numCalls == 2);
+        REQUIRE_FALSE(cache.isMapped());
+    }
+    {
+        //A spectrum estimated to a different accuracy isn't the same spectrum, even from the same noise
+        const NoiseSpectrumSettings otherSettings{testSettings.hopSize, testSettings.window, testSettings.relativeError/2.0};
+        const NoiseCache<float> cache{file, numSamples, numBins, 54321, otherSettings, makeCountingGenerator<float>(numSamples, numBins, numCalls)};
+        REQUIRE(numCalls == 3);
+        REQUIRE_FALSE(cache.isMapped());
+        REQUIRE(NoiseCache<float>::getFile(numSamples, numBins*2, 54321, otherSettings) != file);
+    }
+
+    //Cut the file short, like a write that never finished
+    {
+        const juce::TemporaryFile truncated{file};
+        {
+            juce::FileOutputStream stream{truncated.getFile()};
+            const NoiseCacheHeader header{};
+            REQUIRE(stream.write(&header, sizeof(header)));
+        }
+        REQUIRE(truncated.overwriteTargetFileWithTemporary());
+    }
+    {
+        const NoiseCache<float> cache{file, numSamples, numBins, 54321, testSettings, makeCountingGenerator<float>(numSamples, numBins, numCalls)};
+        REQUIRE(numCalls == 4);
+        REQUIRE_FALSE(cache.isMapped());
+        checkContents<float>(cache, numSamples, numBins);
+    }
+
+    //The replacement is complete, so it's read from now on
+    const NoiseCache<float> cache{file, numSamples, numBins, 54321, testSettings, makeCountingGenerator<float>(numSamples, numBins, numCalls)};
+    REQUIRE(numCalls == 4);
+    REQUIRE(cache.isMapped());
+    checkContents<float>(cache, numSamples, numBins);
+
+    file.deleteFile();
+}
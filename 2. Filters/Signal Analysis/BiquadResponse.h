@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cmath>
+#include <juce_core/juce_core.h>
+
+#include "../../Utilities/AlignedAllocator.h"
+
+//The response of a filter at a set of frequencies, with one value per frequency in each array
+//The phase is in radians, and the group delay is in samples
+template<typename SampleType>
+struct FrequencyResponse
+{
+    AlignedVector<SampleType> magnitudes{}, phases{}, groupDelays{};
+};
+
+//Works out a biquad's magnitude, phase and group delay straight from its coefficients,
+// which is exact, and takes microseconds where measuring the response takes hundreds of thousands of samples
+//The coefficients are normalized so a0 is 1, the same as JUCE's IIR coefficients
+//The response is worked out in double, so the stopband of a float filter is as accurate as its coefficients allow
+//Each frequency is worked out independently without branching, so evaluating a grid of them can be vectorized
+template<typename SampleType>
+class BiquadResponse
+{
+public:
+    constexpr BiquadResponse(SampleType b0, SampleType b1, SampleType b2, SampleType a1, SampleType a2) noexcept
+        : b0(b0), b1(b1), b2(b2), a1(a1), a2(a2) {}
+
+    //Read a set of JUCE's second order IIR coefficients, which are stored as b0, b1, b2, a1, a2
+    template<typename Coefficients>
+    static auto fromCoefficients(const Coefficients& coefficients) noexcept {
+        const auto* rawCoefficients = coefficients.getRawCoefficients();
+        return BiquadResponse{rawCoefficients[0], rawCoefficients[1], rawCoefficients[2], rawCoefficients[3], rawCoefficients[4]};
+    }
+
+    //Read the coefficients of one of JUCE's second order IIR filters, i.e. the ones makeJuceDspIir makes
+    template<typename Filter>
+    static auto fromFilter(const Filter& filter) noexcept {
+        return fromCoefficients(*filter.coefficients);
+    }
+
+    SampleType getMagnitude(SampleType frequency, SampleType sampleRate) const noexcept {
+        SampleType magnitude{};
+        process(&frequency, 1, sampleRate, &magnitude, nullptr, nullptr);
+        return magnitude;
+    }
+
+    SampleType getPhase(SampleType frequency, SampleType sampleRate) const noexcept {
+        SampleType phase{};
+        process(&frequency, 1, sampleRate, nullptr, &phase, nullptr);
+        return phase;
+    }
+
+    SampleType getGroupDelay(SampleType frequency, SampleType sampleRate) const noexcept {
+        SampleType groupDelay{};
+        process(&frequency, 1, sampleRate, nullptr, nullptr, &groupDelay);
+        return groupDelay;
+    }
+
+    //Get the whole response at every frequency in a collection
+    template<typename Collection>
+    auto getResponse(const Collection& frequencies, SampleType sampleRate) const {
+        const auto numFrequencies = static_cast<size_t>(frequencies.size());
+        FrequencyResponse<SampleType> response{AlignedVector<SampleType>(numFrequencies),
+                                               AlignedVector<SampleType>(numFrequencies),
+                                               AlignedVector<SampleType>(numFrequencies)};
+        process(frequencies.data(), numFrequencies, sampleRate,
+                response.magnitudes.data(), response.phases.data(), response.groupDelays.data());
+        return response;
+    }
+
+    //Work out the response at numFrequencies frequencies, writing the parts of it that have somewhere to go
+    // Passing nullptr for an output skips it
+    //At the frequency of a zero on the unit circle, like a notch's, the phase jumps and the group delay isn't defined,
+    // so only the poles' group delay is given there
+    void process(const SampleType* frequencies, size_t numFrequencies, SampleType sampleRate,
+                 SampleType* magnitudes, SampleType* phases, SampleType* groupDelays) const noexcept {
+        const auto radiansPerHz = juce::MathConstants<double>::twoPi/static_cast<double>(sampleRate);
+
+        for (size_t i = 0; i < numFrequencies; ++i) {
+            //cos(2w) and sin(2w) come from cos(w) and sin(w), so each frequency takes a single sin and cos
+            const auto w = static_cast<double>(frequencies[i])*radiansPerHz;
+            const auto cosW = std::cos(w), sinW = std::sin(w);
+            const auto cos2W = 2.0*cosW*cosW-1.0, sin2W = 2.0*sinW*cosW;
+
+            //Each polynomial evaluated at e^-jw, along with the polynomial whose coefficients are multiplied by their delay,
+            // which is what the group delay is the real part of the ratio of
+            const auto numeratorReal = b0+b1*cosW+b2*cos2W;
+            const auto numeratorImag = -(b1*sinW+b2*sin2W);
+            const auto delayedNumeratorReal = b1*cosW+2.0*b2*cos2W;
+            const auto delayedNumeratorImag = -(b1*sinW+2.0*b2*sin2W);
+
+            const auto denominatorReal = 1.0+a1*cosW+a2*cos2W;
+            const auto denominatorImag = -(a1*sinW+a2*sin2W);
+            const auto delayedDenominatorReal = a1*cosW+2.0*a2*cos2W;
+            const auto delayedDenominatorImag = -(a1*sinW+2.0*a2*sin2W);
+
+            const auto numeratorPower = numeratorReal*numeratorReal+numeratorImag*numeratorImag;
+            const auto denominatorPower = denominatorReal*denominatorReal+denominatorImag*denominatorImag;
+
+            const auto numeratorDelay = numeratorPower > 0.0
+                                      ? (delayedNumeratorReal*numeratorReal+delayedNumeratorImag*numeratorImag)/numeratorPower
+                                      : 0.0;
+            const auto denominatorDelay = (delayedDenominatorReal*denominatorReal+delayedDenominatorImag*denominatorImag)/denominatorPower;
+
+            if (magnitudes != nullptr)
+                magnitudes[i] = static_cast<SampleType>(std::sqrt(numeratorPower/denominatorPower));
+            if (phases != nullptr)
+                phases[i] = static_cast<SampleType>(std::atan2(numeratorImag*denominatorReal-numeratorReal*denominatorImag,
+                                                               numeratorReal*denominatorReal+numeratorImag*denominatorImag));
+            if (groupDelays != nullptr)
+                groupDelays[i] = static_cast<SampleType>(numeratorDelay-denominatorDelay);
+        }
+    }
+
+private:
+    double b0, b1, b2, a1, a2;
+};
+
+//Make a grid of numFrequencies frequencies, evenly spaced from dc up to but not including nyquist
+// This puts a frequency in the middle of each bin of an fft twice the grid's size
+template<typename SampleType>
+auto makeFrequencyGrid(size_t numFrequencies, SampleType sampleRate) {
+    AlignedVector<SampleType> frequencies(numFrequencies);
+    for (size_t i = 0; i < numFrequencies; ++i)
+        frequencies[i] = static_cast<SampleType>(i)*sampleRate/static_cast<SampleType>(2*numFrequencies);
+    return frequencies;
+}
@@ -0,0 +1,109 @@
+#include <catch2/catch.hpp>
+
+#include "BiquadResponse.h"
+#include "Signal Analyzers.h"
+
+#include <juce_dsp/juce_dsp.h>
+
+//Make the coefficients for each of the responses the filter tests use, at a cutoff somewhere in the audible range
+template<typename SampleType>
+auto makeTestCoefficients(SampleType sampleRate) {
+    using Coefficients = juce::dsp::IIR::Coefficients<SampleType>;
+    const auto cutoff = GENERATE(SampleType{50}, SampleType{1000}, SampleType{15000});
+    const auto q = SampleType{.7071};
+
+    return std::vector<typename juce::dsp::IIR::Filter<SampleType>::CoefficientsPtr>{
+        Coefficients::makeLowPass(sampleRate, cutoff, q),
+        Coefficients::makeHighPass(sampleRate, cutoff, q),
+        Coefficients::makeBandPass(sampleRate, cutoff, q),
+        Coefficients::makeNotch(sampleRate, cutoff, q),
+        Coefficients::makeAllPass(sampleRate, cutoff, q),
+        Coefficients::makePeakFilter(sampleRate, cutoff, q, SampleType{4}),
+        Coefficients::makeLowShelf(sampleRate, cutoff, q, SampleType{.25}),
+        Coefficients::makeHighShelf(sampleRate, cutoff, q, SampleType{4})};
+}
+
+//Test that the response matches the one JUCE works out from the same coefficients, one frequency at a time
+TEMPLATE_TEST_CASE ("Biquad Response Matches JUCE", "[Biquad Response]", float, double)
+{
+    constexpr auto sampleRate = TestType{44100};
+    const auto frequencies = makeFrequencyGrid<TestType>(512, sampleRate);
+
+    for (const auto& coefficients : makeTestCoefficients(sampleRate)) {
+        const auto response = BiquadResponse<TestType>::fromCoefficients(*coefficients).getResponse(frequencies, sampleRate);
+
+        for (size_t i = 1; i < frequencies.size(); ++i) {
+            const auto magnitude = coefficients->getMagnitudeForFrequency(frequencies[i], sampleRate);
+            const auto phase = coefficients->getPhaseForFrequency(frequencies[i], sampleRate);
+
+            REQUIRE(response.magnitudes[i] == Approx(magnitude).epsilon(1e-4).margin(1e-6));
+            //Compare the phases as points on the unit circle, so a phase of pi and -pi are the same
+            REQUIRE(std::abs(std::polar(1.0, static_cast<double>(response.phases[i]))-std::polar(1.0, phase)) < 1e-4);
+        }
+    }
+}
+
+//Test that the group delay is the rate the phase changes at
+TEST_CASE ("Biquad Group Delay", "[Biquad Response]")
+{
+    constexpr auto sampleRate = 44100.0;
+    constexpr auto step = .01;
+    const auto frequencies = makeFrequencyGrid<double>(256, sampleRate);
+
+    for (const auto& coefficients : makeTestCoefficients(sampleRate)) {
+        const auto biquad = BiquadResponse<double>::fromCoefficients(*coefficients);
+
+        for (size_t i = 1; i < frequencies.size(); ++i) {
+            //Stay clear of a notch's zero, where the phase jumps
+            if (biquad.getMagnitude(frequencies[i], sampleRate) < 1e-3)
+                continue;
+
+            const auto phaseChange = std::remainder(biquad.getPhase(frequencies[i]+step, sampleRate)
+                                                    -biquad.getPhase(frequencies[i]-step, sampleRate),
+                                                    juce::MathConstants<double>::twoPi);
+            const auto radiansPerSample = juce::MathConstants<double>::twoPi*2.0*step/sampleRate;
+
+            REQUIRE(biquad.getGroupDelay(frequencies[i], sampleRate) == Approx(-phaseChange/radiansPerSample).epsilon(1e-4).margin(1e-6));
+        }
+    }
+
+    //A delay of one sample in the numerator delays every frequency by one sample
+    const BiquadResponse<double> delay{0, 1, 0, 0, 0};
+    for (const auto& frequency : frequencies)
+        REQUIRE(delay.getGroupDelay(frequency, sampleRate) == Approx(1.0));
+}
+
+//Test that the response matches the level and phase of a sin run through the filter, once it has settled
+TEMPLATE_TEST_CASE ("Biquad Response Matches Measurement", "[Biquad Response]", float, double)
+{
+    constexpr auto sampleRate = TestType{44100};
+    constexpr size_t settlingLength = 20000;
+    const auto frequency = GENERATE(TestType{100}, TestType{3000}, TestType{18000});
+    const auto length = GoertzelAnalyzer<TestType>::getWholePeriodLength(frequency, sampleRate, 4096, 44100);
+
+    for (const auto& coefficients : makeTestCoefficients(sampleRate)) {
+        juce::dsp::IIR::Filter<TestType> filter{coefficients};
+        GoertzelAnalyzer<TestType> input{}, output{};
+        input.setFrequency(frequency, sampleRate);
+        output.setFrequency(frequency, sampleRate);
+
+        for (size_t i = 0; i < settlingLength+length; ++i) {
+            const auto sample = static_cast<TestType>(std::sin(juce::MathConstants<double>::twoPi*frequency*i/sampleRate));
+            const auto filtered = filter.processSample(sample);
+            if (i >= settlingLength) {
+                input.update(sample);
+                output.update(filtered);
+            }
+        }
+
+        const auto biquad = BiquadResponse<TestType>::fromFilter(filter);
+        REQUIRE(output.getAmplitude()/input.getAmplitude() == Approx(biquad.getMagnitude(frequency, sampleRate)).epsilon(1e-3).margin(1e-4));
+
+        if (biquad.getMagnitude(frequency, sampleRate) > 1e-2) {
+            const auto phaseDifference = std::remainder(static_cast<double>(output.getPhase()-input.getPhase()
+                                                                            -biquad.getPhase(frequency, sampleRate)),
+                                                        juce::MathConstants<double>::twoPi);
+            REQUIRE(phaseDifference == Approx(0.0).margin(1e-3));
+        }
+    }
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include <juce_core/juce_core.h>
+
+#include "FFT/FFTTableCache.h"
+#include "../../1. Oscillator/Oscillator.h"
+#include "../../Utilities/AlignedAllocator.h"
+
+//The responses recovered from a recording of an exponential sweep
+// linear is the impulse response of the linear part of whatever the sweep was played through,
+// and harmonics[k-2] is the impulse response of its kth harmonic distortion product
+//The spectrum of a harmonic's response at a frequency is the level of that harmonic, relative to the input,
+// when the input is at the frequency divided by k
+template<typename SampleType>
+struct SweepResponse
+{
+    AlignedVector<SampleType> linear{};
+    std::vector<AlignedVector<SampleType>> harmonics{};
+};
+
+//An exponential sine sweep, for measuring a whole response with a single render,
+// following Farina's "Simultaneous measurement of impulse response and distortion with a swept-sine technique"
+//The sweep's frequency rises exponentially, so it spends the same time in every octave,
+// and each harmonic of it is the same sweep started a fixed time earlier.
+// Dividing a recording's spectrum by the sweep's leaves the linear response at time 0, and each harmonic's response
+// that fixed time before it, which wraps round to the end of the deconvolved buffer, clear of the linear response
+//The sweep is synchronized, following Novak et al's "Synchronized Swept-Sine: Theory, Application, and Implementation",
+// so each harmonic starts a whole number of cycles into the sweep it's a copy of.
+// Otherwise each harmonic is shifted in phase as well as time, which smears its response out over a long tail
+//The sweep is rendered with an Oscillator, frequency modulated a sample at a time, so its phase is accumulated in double
+//The deconvolution is done in double with a single fft of the whole recording, shared with every other double fft of the same size.
+// The sweep's inverse spectra are worked out once, when it's made, so each recording only costs the fft there and back
+template<typename SampleType>
+class ExponentialSweep
+{
+public:
+    //Sweep from startFrequency to endFrequency over about numSamples, for recordings that carry on for up to tailLength samples after it
+    //Synchronizing the sweep rounds how fast it rises, so its length is rounded to fit, see getNumSamples
+    //The response is only measured between the two, and each harmonic from k times the start frequency up to the end
+    ExponentialSweep(SampleType startFrequency, SampleType endFrequency, size_t numSamples, SampleType sampleRate, size_t tailLength) {
+        if (!(startFrequency > SampleType{0} && startFrequency < endFrequency && endFrequency <= sampleRate/SampleType{2}))
+            throw std::invalid_argument("An exponential sweep has to rise from above 0 to at most nyquist");
+
+        //The sweep is synchronized when it takes a whole number of cycles of the start frequency to rise by a factor of e
+        const auto start = static_cast<double>(startFrequency), rate = static_cast<double>(sampleRate);
+        const auto numNepers = std::log(static_cast<double>(endFrequency)/start);
+        const auto cyclesPerNeper = std::max(std::round(start*static_cast<double>(numSamples)/(rate*numNepers)), 1.0);
+        samplesPerNeper = cyclesPerNeper*rate/start;
+        bandEdges = {start/rate, static_cast<double>(endFrequency)/rate};
+        signal.resize(static_cast<size_t>(std::round(samplesPerNeper*numNepers)));
+
+        //Render the frequencies into the signal's buffer, and then the oscillator writes over them
+        //Each frequency is the average over its sample, rather than the frequency at its start,
+        // so the phase the oscillator adds up is the sweep's exact phase at every sample
+        const auto averageScale = samplesPerNeper*std::expm1(1.0/samplesPerNeper);
+        for (size_t i = 0; i < signal.size(); ++i)
+            signal[i] = static_cast<SampleType>(start*averageScale*std::exp(static_cast<double>(i)/samplesPerNeper));
+
+        Oscillator<SampleType, PhaseAccumulation::Incremental> oscillator{};
+        oscillator.setSampleRate(sampleRate);
+        oscillator.setFrequency(startFrequency);
+        oscillator.setWaveform(std::make_unique<SinShaper<SampleType>>());
+        oscillator.process(signal.data(), signal.data(), signal.size());
+
+        transformSize = size_t{1};
+        while (transformSize < signal.size()+tailLength)
+            transformSize *= 2;
+        makeInverseSpectra();
+    }
+
+    const auto& getSignal() const noexcept { return signal; }
+
+    //The length of the sweep, which is within half a cycle of the start frequency per neper it rises by
+    // of the length it was asked for
+    size_t getNumSamples() const noexcept { return signal.size(); }
+
+    //How many samples before the linear response the kth harmonic's response lands
+    double getHarmonicDelay(size_t harmonic) const noexcept {
+        return samplesPerNeper*std::log(static_cast<double>(harmonic));
+    }
+
+    //How many samples early each harmonic's response starts
+    //A harmonic's delay is a fraction of a sample out, so its response rings either side of where it lands,
+    // and starting it early keeps the ringing before that, which its level depends on
+    static constexpr size_t harmonicLeadIn = 32;
+
+    //The most samples a recording can carry on for after the sweep, and so the longest response it can recover
+    size_t getTailLength() const noexcept { return transformSize-getNumSamples(); }
+
+    //Recover the responses from a recording of the sweep, which should carry on for at least responseLength samples after it,
+    // so the tail of the response is in the recording
+    //Each response is responseLength samples long, which has to fit between neighbouring harmonics
+    template<typename Recording>
+    auto deconvolve(const Recording& recording, size_t responseLength, size_t numHarmonics = 0) const {
+        if (static_cast<size_t>(recording.size()) > transformSize || responseLength > getTailLength())
+            throw std::invalid_argument("The recording is longer than the sweep's tail length allows for");
+        if (numHarmonics >= 2 && !(responseLength+harmonicLeadIn <= getHarmonicDelay(2)
+                                   && responseLength <= getHarmonicDelay(numHarmonics)-getHarmonicDelay(numHarmonics-1)
+                                   && getHarmonicDelay(numHarmonics)+harmonicLeadIn+responseLength <= transformSize))
+            throw std::invalid_argument("The harmonics' responses don't fit between each other");
+
+        using Complex = std::complex<double>;
+        AlignedVector<Complex> recordingSpectrum(transformSize), response(transformSize);
+        std::copy(recording.begin(), recording.end(), recordingSpectrum.begin());
+
+        const auto fft = FFTTableCache<double>::getFFT(transformSize);
+        fft->perform(recordingSpectrum.data(), recordingSpectrum.data(), false);
+
+        //Multiply the recording's spectrum by one of the sweep's inverses, then transform the result back
+        const auto divide = [&](const AlignedVector<Complex>& inverse) {
+            for (size_t i = 0; i < transformSize; ++i)
+                response[i] = recordingSpectrum[i]*inverse[i];
+            fft->perform(response.data(), response.data(), true);
+        };
+
+        //The harmonics are before the linear response, so their responses wrap round to the end of the buffer
+        const auto copyResponse = [this, &response, responseLength](size_t start) {
+            AlignedVector<SampleType> samples(responseLength);
+            for (size_t i = 0; i < responseLength; ++i)
+                samples[i] = static_cast<SampleType>(response[(start+i)%transformSize].real());
+            return samples;
+        };
+
+        //The linear response starts at 0, so it comes from the exact inverse, which leaves a linear system's response causal.
+        // Limiting it to the sweep's band would spread it either side of 0, and cut off the part before
+        SweepResponse<SampleType> sweepResponse{};
+        divide(linearInverse);
+        sweepResponse.linear = copyResponse(0);
+        if (numHarmonics < 2)
+            return sweepResponse;
+
+        //Outside of the sweep its spectrum is close to 0, so the exact inverse blows up whatever else the recording has there,
+        // like harmonics above the end of the sweep, and spreads it over every harmonic's response.
+        // Regularizing those bins heavily leaves them out, and the sweep's spectrum falls away smoothly at its ends,
+        // so the responses only ring a little either side of where they land, which the lead in keeps
+        divide(harmonicInverse);
+        for (size_t harmonic = 2; harmonic <= numHarmonics; ++harmonic) {
+            const auto delay = static_cast<size_t>(std::floor(getHarmonicDelay(harmonic)))+harmonicLeadIn;
+            sweepResponse.harmonics.push_back(copyResponse(transformSize-delay));
+        }
+        return sweepResponse;
+    }
+
+private:
+    //How many samples the sweep takes to rise by a factor of e
+    double samplesPerNeper{};
+    //The start and end frequencies, as fractions of the sample rate
+    std::array<double, 2> bandEdges{};
+    AlignedVector<SampleType> signal{};
+
+    //The size of the fft a recording is deconvolved with, which fits the sweep and its tail
+    size_t transformSize{};
+    //The sweep's spectrum inverted, regularized barely at all inside the sweep,
+    // and outside of it either barely at all for the linear response, or heavily for the harmonics
+    AlignedVector<std::complex<double>> linearInverse{}, harmonicInverse{};
+
+    void makeInverseSpectra() {
+        AlignedVector<std::complex<double>> sweepSpectrum(transformSize);
+        std::copy(signal.begin(), signal.end(), sweepSpectrum.begin());
+        FFTTableCache<double>::getFFT(transformSize)->perform(sweepSpectrum.data(), sweepSpectrum.data(), false);
+
+        auto peakPower = 0.0;
+        for (const auto& bin : sweepSpectrum)
+            peakPower = std::max(peakPower, std::norm(bin));
+
+        const auto invert = [&](double outsideRegularization) {
+            AlignedVector<std::complex<double>> inverse(transformSize);
+            for (size_t i = 0; i < transformSize; ++i) {
+                const auto frequency = static_cast<double>(std::min(i, transformSize-i))/static_cast<double>(transformSize);
+                const auto isInside = frequency >= bandEdges[0] && frequency <= bandEdges[1];
+                const auto regularization = (isInside ? 1e-10 : outsideRegularization)*peakPower;
+                inverse[i] = std::conj(sweepSpectrum[i])/(std::norm(sweepSpectrum[i])+regularization);
+            }
+            return inverse;
+        };
+        linearInverse = invert(1e-10);
+        harmonicInverse = invert(1.0);
+    }
+};
+
+//Holds every exponential sweep that's been asked for, so measurements with the same sweep only render and invert it once
+//Like FFTTableCache, each sweep is never changed after it's made, so it can be read from any thread,
+// and only finding or adding one takes the lock
+template<typename SampleType>
+class ExponentialSweepCache
+{
+public:
+    static std::shared_ptr<const ExponentialSweep<SampleType>> getSweep(SampleType startFrequency, SampleType endFrequency,
+                                                                        size_t numSamples, SampleType sampleRate, size_t tailLength) {
+        auto& cache = get();
+        const std::lock_guard<std::mutex> lock{cache.mutex};
+
+        auto& sweep = cache.sweeps[{startFrequency, endFrequency, numSamples, sampleRate, tailLength}];
+        if (sweep == nullptr)
+            sweep = std::make_shared<const ExponentialSweep<SampleType>>(startFrequency, endFrequency, numSamples, sampleRate, tailLength);
+        return sweep;
+    }
+
+private:
+    std::mutex mutex{};
+    std::map<std::tuple<SampleType, SampleType, size_t, SampleType, size_t>, std::shared_ptr<const ExponentialSweep<SampleType>>> sweeps{};
+
+    ExponentialSweepCache() = default;
+
+    static ExponentialSweepCache& get() {
+        static ExponentialSweepCache cache{};
+        return cache;
+    }
+};
@@ -0,0 +1,162 @@
+#include <catch2/catch.hpp>
+
+#include "ExponentialSweep.h"
+#include "ImpulseResponse.h"
+#include "BiquadResponse.h"
+#include "../../Utilities/DecibelMatchers.h"
+#include "../FilterMeasurementUtilities.h"
+
+#include <juce_dsp/juce_dsp.h>
+
+//Run a sweep through a function a sample at a time, and carry on with silence for the tail
+template<typename SampleType, typename Function>
+auto recordSweep(const ExponentialSweep<SampleType>& sweep, size_t tailLength, Function&& process) {
+    AlignedVector<SampleType> recording(sweep.getNumSamples()+tailLength);
+    std::copy(sweep.getSignal().begin(), sweep.getSignal().end(), recording.begin());
+    std::transform(recording.begin(), recording.end(), recording.begin(), process);
+    return recording;
+}
+
+//Test that the sweep is a unit level sin, which sweeps between the frequencies it was asked for,
+// and is synchronized, so every harmonic of it is a whole number of cycles into the sweep
+TEMPLATE_TEST_CASE ("Exponential Sweep Signal", "[Exponential Sweep]", float, double)
+{
+    constexpr auto sampleRate = 44100.0;
+    constexpr size_t numSamples = 1 << 16;
+    const ExponentialSweep<TestType> sweep{TestType{20}, TestType{20000}, numSamples, static_cast<TestType>(sampleRate), 0};
+    const auto& signal = sweep.getSignal();
+
+    REQUIRE(signal[0] == Approx(0.0).margin(1e-6));
+    for (const auto& sample : signal)
+        REQUIRE(std::abs(sample) <= TestType{1});
+
+    //The sweep rises by a factor of e in a whole number of cycles of its start frequency
+    const auto samplesPerNeper = sweep.getHarmonicDelay(2)/std::log(2.0);
+    const auto cyclesPerNeper = samplesPerNeper*20.0/sampleRate;
+    REQUIRE(cyclesPerNeper == Approx(std::round(cyclesPerNeper)).margin(1e-9));
+    REQUIRE(sweep.getNumSamples() == static_cast<size_t>(std::round(samplesPerNeper*std::log(1000.0))));
+    REQUIRE(std::abs(static_cast<double>(sweep.getNumSamples())-static_cast<double>(numSamples)) <= sampleRate/20.0*std::log(1000.0)/2.0);
+
+    //Count the rising zero crossings to find how many cycles the sweep goes through
+    const auto countCycles = [&signal](size_t start, size_t end) {
+        size_t numCrossings = 0;
+        for (size_t i = start+1; i < end; ++i)
+            if (signal[i-1] < TestType{0} && signal[i] >= TestType{0})
+                ++numCrossings;
+        return static_cast<double>(numCrossings);
+    };
+
+    //The sweep's phase is the integral of its frequency, so it goes through samplesPerNeper times the rise in frequency,
+    // and the last few samples' worth of cycles are from the frequency just before the end
+    constexpr size_t endLength = 441;
+    const auto numCycles = samplesPerNeper*(20000.0-20.0)/sampleRate;
+    const auto numEndCycles = samplesPerNeper*20000.0*-std::expm1(-static_cast<double>(endLength)/samplesPerNeper)/sampleRate;
+    REQUIRE(countCycles(0, signal.size()) == Approx(numCycles).margin(1.0));
+    REQUIRE(countCycles(signal.size()-endLength, signal.size()) == Approx(numEndCycles).margin(1.0));
+
+    //A harmonic is the same sweep, started early by however long the sweep takes to rise by that harmonic
+    REQUIRE(sweep.getHarmonicDelay(1) == Approx(0.0));
+    REQUIRE(sweep.getHarmonicDelay(4) == Approx(2.0*sweep.getHarmonicDelay(2)));
+}
+
+//Test that a delay is recovered as an impulse at the delay
+TEST_CASE ("Exponential Sweep Delay", "[Exponential Sweep]")
+{
+    constexpr size_t delay = 37;
+    const ExponentialSweep<double> sweep{20.0, 20000.0, 1 << 16, 44100.0, 256};
+
+    std::vector<double> line(delay+1);
+    size_t position = 0;
+    const auto response = sweep.deconvolve(recordSweep(sweep, 256, [&](const auto& sample) {
+        line[position] = sample;
+        position = (position+1)%line.size();
+        return line[position];
+    }), 256).linear;
+
+    const auto peak = std::max_element(response.begin(), response.end(), [](auto a, auto b) { return std::abs(a) < std::abs(b); });
+    REQUIRE(static_cast<size_t>(peak-response.begin()) == delay);
+    REQUIRE(*peak == Approx(1.0).epsilon(.05));
+}
+
+//Test that the response measured from one sweep through a filter matches the response worked out from its coefficients,
+// everywhere inside the sweep
+TEMPLATE_TEST_CASE ("Exponential Sweep Matches Biquad Response", "[Exponential Sweep]", float, double)
+{
+    using Coefficients = juce::dsp::IIR::Coefficients<TestType>;
+    constexpr size_t fftSize = 1024;
+    constexpr size_t responseLength = 8192;
+    constexpr auto sampleRate = TestType{44100};
+    const auto cutoff = GENERATE(TestType{100}, TestType{1000}, TestType{10000});
+    const auto q = TestType{.7071};
+
+    const ExponentialSweep<TestType> sweep{TestType{20}, TestType{21000}, 1 << 16, sampleRate, responseLength};
+    const auto frequencies = makeFrequencyGrid<TestType>(fftSize/2, sampleRate);
+
+    for (const auto& coefficients : {Coefficients::makeLowPass(sampleRate, cutoff, q),
+                                     Coefficients::makeHighPass(sampleRate, cutoff, q),
+                                     Coefficients::makeBandPass(sampleRate, cutoff, q),
+                                     Coefficients::makePeakFilter(sampleRate, cutoff, q, TestType{4})}) {
+        juce::dsp::IIR::Filter<TestType> filter{coefficients};
+        const auto measured = getImpulseResponseSpectrum<TestType>(measureSweepResponse(filter, sweep, responseLength).linear, fftSize);
+        const auto expected = BiquadResponse<TestType>::fromCoefficients(*coefficients).getResponse(frequencies, sampleRate);
+
+        //Only the bins well inside the sweep, clear of the edges the sweep starts and stops at
+        for (size_t i = 2; i < fftSize/2-40; ++i) {
+            const Decibel<TestType> measuredLevel = Amplitude{std::max(measured.magnitudes[i], TestType{1e-6})};
+            const Decibel<TestType> expectedLevel = Amplitude{std::max(expected.magnitudes[i], TestType{1e-6})};
+            REQUIRE(measuredLevel.count() == Approx(expectedLevel.count()).margin(.1));
+        }
+    }
+}
+
+//Test that a memoryless nonlinearity's harmonics are separated from its linear response, at the levels they're added at
+//x + a*x^2 + b*x^3 turns a unit sin into a fundamental at 1 + 3b/4, a second harmonic at a/2, and a third at b/4
+TEST_CASE ("Exponential Sweep Harmonics", "[Exponential Sweep]")
+{
+    constexpr auto sampleRate = 44100.0;
+    constexpr size_t fftSize = 1024;
+    constexpr size_t responseLength = 1024;
+    constexpr auto a = .1, b = .2;
+
+    const ExponentialSweep<double> sweep{20.0, 20000.0, 1 << 16, sampleRate, responseLength};
+    const auto response = sweep.deconvolve(recordSweep(sweep, responseLength, [](const auto& x) { return x+a*x*x+b*x*x*x; }),
+                                           responseLength, 3);
+    REQUIRE(response.harmonics.size() == 2);
+
+    const auto linear = getImpulseResponseSpectrum<double>(response.linear, fftSize);
+    const auto second = getImpulseResponseSpectrum<double>(response.harmonics[0], fftSize);
+    const auto third  = getImpulseResponseSpectrum<double>(response.harmonics[1], fftSize);
+
+    //Each harmonic is measured from k times the start of the sweep up to its end.
+    //The lowest bins are only a few cycles of the response's length, so they're left out,
+    // and so are the bins the third harmonic's aliases fold back over, for the linear response and the second harmonic
+    for (size_t i = 4; i < 224; ++i)
+        REQUIRE(linear.magnitudes[i] == Approx(1.0+.75*b).epsilon(.01));
+    for (size_t i = 24; i < 368; ++i)
+        REQUIRE(second.magnitudes[i] == Approx(a/2.0).epsilon(.05));
+    for (size_t i = 8; i < 416; ++i)
+        REQUIRE(third.magnitudes[i] == Approx(b/4.0).epsilon(.05));
+}
+
+//Test that a sweep that can't be made, or a recording too long for the sweep to deconvolve, is refused rather than measured wrong
+TEST_CASE ("Exponential Sweep Arguments", "[Exponential Sweep]")
+{
+    constexpr auto sampleRate = 44100.0;
+    REQUIRE_THROWS_AS((ExponentialSweep<double>{0.0, 20000.0, 1 << 14, sampleRate, 0}), std::invalid_argument);
+    REQUIRE_THROWS_AS((ExponentialSweep<double>{20000.0, 20.0, 1 << 14, sampleRate, 0}), std::invalid_argument);
+    REQUIRE_THROWS_AS((ExponentialSweep<double>{20.0, sampleRate, 1 << 14, sampleRate, 0}), std::invalid_argument);
+
+    const ExponentialSweep<double> sweep{20.0, 20000.0, 1 << 14, sampleRate, 1024};
+    REQUIRE(sweep.getTailLength() >= 1024);
+    REQUIRE_THROWS_AS(sweep.deconvolve(AlignedVector<double>(sweep.getNumSamples()+sweep.getTailLength()+1), 256), std::invalid_argument);
+    REQUIRE_THROWS_AS(sweep.deconvolve(AlignedVector<double>(sweep.getNumSamples()), sweep.getTailLength()+1), std::invalid_argument);
+    REQUIRE_NOTHROW(sweep.deconvolve(AlignedVector<double>(sweep.getNumSamples()+sweep.getTailLength()), sweep.getTailLength()));
+}
+
+//Test that asking the cache for the same sweep twice gives the same sweep, so it's only rendered once
+TEST_CASE ("Exponential Sweep Cache", "[Exponential Sweep]")
+{
+    const auto sweep = ExponentialSweepCache<float>::getSweep(20.f, 20000.f, 1 << 14, 44100.f, 1024);
+    REQUIRE(ExponentialSweepCache<float>::getSweep(20.f, 20000.f, 1 << 14, 44100.f, 1024) == sweep);
+    REQUIRE(ExponentialSweepCache<float>::getSweep(20.f, 20000.f, 1 << 14, 48000.f, 1024) != sweep);
+}
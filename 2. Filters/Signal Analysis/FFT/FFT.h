@@ -1,75 +1,182 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <optional>
+#include <type_traits>
 #include <juce_dsp/juce_dsp.h>
 
+#include "FFTTableCache.h"
+
 //#include "FFTUtils.h"
 
 //#include "../../Sinecure-Audio-Library/Utilities/Units/include/Units.h"
 
-template<size_t FFTSize>
+//Passing this as FFTHelper's size means the size is chosen at runtime, and passed to the constructor instead
+// i.e. FFTHelper<RuntimeFFTSize, double> fft{65536, 16384};
+constexpr size_t RuntimeFFTSize = 0;
+
+//Transforms a stream of samples into a stream of magnitude spectra
+//Each frame is windowed with a Hann window by default, or any of the other FFTWindows, and scaled to read sin or noise levels
+//A frame is output every hop size samples, made from the last FFTSize samples, so frames overlap when the hop is smaller than the fft
+// A hop of FFTSize/2 or FFTSize/4 gives 50% or 75% overlap, which the Hann window sums to a flat gain with,
+// and gets two or four times as many frames out of the same input
+//The input is kept in a ring buffer, and each frame is windowed straight out of the ring into the fft's buffer
+//Float ffts use JUCE's fft, and other types use a radix 2 fft in the same type, so doubles aren't narrowed to float
+//The fft and window table are shared with every other helper of the same size and type, through FFTTableCache
+//Every buffer is on the heap, aligned to a cache line, so large ffts don't overflow the stack. The size must be a power of 2
+template<size_t FFTSize, typename SampleType = float>
 class FFTHelper
 {
+    using Tables = FFTTableCache<SampleType>;
+
 public:
+    //Each frame holds twice as many values as the size of the fft, with the magnitude of each bin in the first half
+    using Frame = AlignedVector<SampleType>;
+
+    //The default hop is the size of the fft, which outputs back to back frames that don't overlap
+    explicit FFTHelper(size_t newHopSize = FFTSize,
+                       FFTWindow windowType = FFTWindow::Hann,
+                       FFTScaling scaling = FFTScaling::SinLevel)
+        : FFTHelper(FFTSize, newHopSize, windowType, scaling, 0) {
+        static_assert(FFTSize != RuntimeFFTSize, "An fft with a runtime size needs its size passed to the constructor");
+    }
+
+    //Make an fft with a size chosen at runtime, which has to be a power of 2
+    //Any other size throws std::invalid_argument, from FFTTableCache::getFFT, before the helper is made
+    FFTHelper(size_t newFFTSize, size_t newHopSize,
+              FFTWindow windowType = FFTWindow::Hann,
+              FFTScaling scaling = FFTScaling::SinLevel)
+        : FFTHelper(newFFTSize, newHopSize, windowType, scaling, 0) {
+        static_assert(FFTSize == RuntimeFFTSize, "An fft with a fixed size can't be given a different size");
+    }
+
 //    FFT
     constexpr const auto& getFFTData() const noexcept {
         return fftData;
     }
 
-    std::optional<std::reference_wrapper<const std::array<float, FFTSize*2>>>
-    pushNextSampleIntoFifo (float sample) noexcept
+    constexpr auto getSize() const noexcept { return fftSize; }
+
+    //Set how many samples to move forward between frames, which is clamped between 1 and the size of the fft
+    // This doesn't change when the next frame is due, so the hop can change without losing the current frame
+    void setHopSize(size_t newHopSize) noexcept {
+        hopSize = std::clamp(newHopSize, size_t{1}, fftSize);
+    }
+
+    constexpr auto getHopSize() const noexcept { return hopSize; }
+
+    //Change the window and scaling used for the next frame onwards
+    void setWindow(FFTWindow windowType, FFTScaling scaling = FFTScaling::SinLevel) {
+        window = Tables::getScaledWindow(fftSize, windowType, scaling);
+    }
+
+    //How many bins of white noise each bin of the window lets through, see ScaledWindow
+    auto getEquivalentNoiseBandwidth() const noexcept { return window->equivalentNoiseBandwidth; }
+
+    //How much lower a sin halfway between two bins reads than one in the middle of a bin, as a gain, see ScaledWindow
+    auto getScallopingGain() const noexcept { return window->scallopingGain; }
+
+    std::optional<std::reference_wrapper<const Frame>>
+    pushNextSampleIntoFifo (SampleType sample) noexcept
     {
-        //If we've received enough samples to output a frame:
-        // reset the data buffer, window our input, normalize the level, and then transform the data
-        //Then, reset the sample counter and return a reference to the frame
-        if (fftInputIndex == FFTSize) {
-            std::fill (fftData.begin()+FFTSize, fftData.end(), 0.0f);
-            std::copy (fftInput.begin(), fftInput.end(), fftData.begin());
-            windowFFTData();
-            scaleFFTData();
-            forwardFFT.performFrequencyOnlyForwardTransform (fftData.data());
-
-            fftInputIndex = 0;
-            fftInput[fftInputIndex++] = sample;
+        ring[writeIndex] = sample;
+        writeIndex = (writeIndex+1)%fftSize;
+
+        //If we've received enough samples to output a frame, transform them and return a reference to the frame
+        if (--samplesUntilNextFrame == 0) {
+            performFrame();
             return fftData;
         }
         //If we're not ready to return a frame, return a nullopt
         else {
-            fftInput[fftInputIndex++] = sample;
             return {};
         }
     }
 
-    auto perform (float sample) noexcept {
+    auto perform (SampleType sample) noexcept {
         return pushNextSampleIntoFifo (sample);
     }
 
-    //Reset all fft data to 0
+    //Push a block of samples, calling onFrame with a reference to each frame as it's completed
+    // The samples between frames are copied into the ring in bulk, so there's no per sample check for a frame
+    //The samples can be any type that converts to the fft's type
+    template<typename InputType, typename FrameCallback>
+    void pushBlock (const InputType* samples, size_t numSamples, FrameCallback&& onFrame)
+    {
+        while (numSamples > 0) {
+            const auto numToWrite = std::min(numSamples, samplesUntilNextFrame);
+            writeToRing(samples, numToWrite);
+            samples += numToWrite;
+            numSamples -= numToWrite;
+
+            samplesUntilNextFrame -= numToWrite;
+            if (samplesUntilNextFrame == 0) {
+                performFrame();
+                onFrame(getFFTData());
+            }
+        }
+    }
+
+    //Reset all fft data to 0, and wait for a full fft's worth of samples before the next frame
     void reset() {
-        std::fill (fftData.begin(), fftData.end(), 0.0f);
-        std::fill (fftInput.begin(), fftInput.end(), 0.0f);
+        std::fill (fftData.begin(), fftData.end(), SampleType{0});
+        std::fill (ring.begin(), ring.end(), SampleType{0});
+        writeIndex = 0;
+        samplesUntilNextFrame = fftSize;
     }
 
 private:
-    juce::dsp::FFT forwardFFT{ juce::roundToInt(std::log2(FFTSize)) };
-    std::array<float, FFTSize> fftInput{};
-    std::array<float, FFTSize * 2> fftData{};
-//    std::vector<float> fftInput{FFTSize};
-//    std::vector<float> fftData{FFTSize*2};
+    size_t fftSize;
+    std::shared_ptr<const typename Tables::FFTType> forwardFFT = Tables::getFFT(fftSize);
+    //The window with the fft's normalization already applied, so each frame is windowed and scaled in the same multiply
+    std::shared_ptr<const typename Tables::WindowTable> window{};
+    AlignedVector<SampleType> ring = AlignedVector<SampleType>(fftSize);
+    Frame fftData = Frame(fftSize*2);
+
+    //The ring's oldest sample is the one that will be written over next
+    size_t writeIndex{ 0 };
+    size_t hopSize{ fftSize };
+    size_t samplesUntilNextFrame{ fftSize };
+
+    //Both public constructors pass their size here, after checking they're the right one for the template
+    FFTHelper(size_t newFFTSize, size_t newHopSize, FFTWindow windowType, FFTScaling scaling, int) : fftSize(newFFTSize) {
+        setHopSize(newHopSize);
+        setWindow(windowType, scaling);
+    }
 
-    size_t fftInputIndex{ 0 };
-    juce::dsp::WindowingFunction<float> windowFunc{FFTSize, juce::dsp::WindowingFunction<float>::WindowingMethod::hann};
+    //Copy up to a whole fft's worth of samples into the ring, wrapping at most once
+    template<typename InputType>
+    void writeToRing(const InputType* samples, size_t numSamples) noexcept {
+        const auto numBeforeWrap = std::min(numSamples, fftSize-writeIndex);
+        std::copy(samples, samples+numBeforeWrap, ring.begin()+writeIndex);
+        std::copy(samples+numBeforeWrap, samples+numSamples, ring.begin());
+        writeIndex = (writeIndex+numSamples)%fftSize;
+    }
+
+    //Window and normalize the last fft's worth of samples, and transform them into a frame
+    // Then wait a hop before the next frame
+    void performFrame() noexcept {
+        windowFFTData();
+        forwardFFT->performFrequencyOnlyForwardTransform (fftData.data());
+        samplesUntilNextFrame = hopSize;
+    }
 
-    //Apply a Hann Window to the FFT data
+    //Apply the scaled window to the samples in the ring, oldest first, and put them in the FFT data
+    // The ring wraps at most once, so this is two straight loops instead of wrapping every index,
+    // and each one is a single multiply per sample between three non-overlapping buffers, which vectorizes
+    //The fft only reads the lower half of the data as input, so the upper half doesn't need clearing
     void windowFFTData() noexcept {
-        const auto windowSize = fftData.size()/2;
-        windowFunc.multiplyWithWindowingTable(fftData.data(), windowSize);
+        const auto numBeforeWrap = fftSize-writeIndex;
+        applyWindow(fftData.data(), ring.data()+writeIndex, window->table.data(), numBeforeWrap);
+        applyWindow(fftData.data()+numBeforeWrap, ring.data(), window->table.data()+numBeforeWrap, writeIndex);
     }
 
-    //Normalize the FFT data
-    auto scaleFFTData() noexcept {
-        for(auto&& sample : fftData)
-            sample *= 2.0f / FFTSize;
+    //The buffers are marked __restrict, so the compiler knows writing the output can't change the samples or the window,
+    // and vectorizes the loop without checking whether they overlap first
+    static void applyWindow(SampleType* __restrict output, const SampleType* __restrict samples,
+                            const SampleType* __restrict windowTable, size_t numSamples) noexcept {
+        for (size_t i = 0; i < numSamples; ++i)
+            output[i] = samples[i]*windowTable[i];
     }
 };
\ No newline at end of file
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <complex>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <juce_dsp/juce_dsp.h>
+
+#include "RadixTwoFFT.h"
+#include "../../../Utilities/AlignedAllocator.h"
+
+// Tagged value for choosing the window FFTHelper applies to each frame
+// Hann is a good default. BlackmanHarris leaks much less into distant bins, so quiet components near loud ones can be seen with a smaller fft.
+// FlatTop reads a sin's level accurately wherever it lands between bins, at the cost of a wide peak
+// i.e. FFTHelper<1024> fft{512, FFTWindow::FlatTop};
+enum FFTWindow {
+    Hann, BlackmanHarris, FlatTop
+};
+
+// Tagged value for choosing what the levels in an FFTHelper's frames mean
+// SinLevel corrects for the window's coherent gain, so a sin in the middle of a bin reads as its amplitude, whatever the window
+// NoiseLevel corrects for the window's equivalent noise bandwidth instead, so white noise reads as the same level whatever the window
+enum FFTScaling {
+    SinLevel, NoiseLevel
+};
+
+//A window table with the fft's normalization already applied, so a frame can be windowed and scaled with a single multiply
+// Along with the table are the window's corrections, for interpreting the levels it gives
+template<typename SampleType>
+struct ScaledWindow
+{
+    AlignedVector<SampleType> table{};
+    //How many bins wide a brick wall filter that passes the same noise power as one bin of this window would be
+    // Hann is 1.5 bins, Blackman-Harris is 2 and the flat top is 3
+    SampleType equivalentNoiseBandwidth{1};
+    //The level a sin halfway between two bins reads at, relative to a sin in the middle of a bin
+    // This is the most the level of a sin can be underestimated by, so levels can be read with a known tolerance
+    // Hann reads up to 1.42dB low, Blackman-Harris .82dB, and the flat top is within .02dB
+    SampleType scallopingGain{1};
+};
+
+//Holds the ffts and window tables FFTHelper uses, so every helper with the same size and type shares one copy
+//The filter tests make a new helper for every cutoff they sweep through, which would otherwise build the same tables hundreds of times
+//Each fft and table is built the first time it's asked for, and is never changed after that,
+// so the helpers can read them from any thread. Only finding or adding an entry takes the lock
+//JUCE's fallback fft takes a lock of its own while it transforms large sizes, so threads sharing one would wait on each other.
+// Those are kept per thread instead, so helpers on the same thread share them, but separate threads never do
+//Entries are kept for the life of the program, or of the thread for JUCE's ffts,
+// since the tests make and destroy helpers of the same sizes over and over
+template<typename SampleType>
+class FFTTableCache
+{
+public:
+    //Float ffts use JUCE's fft, and other types use a radix 2 fft in the same type
+    using FFTType = std::conditional_t<std::is_same_v<SampleType, float>, juce::dsp::FFT, RadixTwoFFT<SampleType>>;
+    using WindowTable = ScaledWindow<SampleType>;
+
+    //Get the fft for a power of 2 size, which throws std::invalid_argument for any other size
+    static std::shared_ptr<const FFTType> getFFT(size_t size) {
+        //JUCE counts 0 as a power of 2
+        if (size == 0 || !juce::isPowerOfTwo(size))
+            throw std::invalid_argument("An fft's size has to be a power of 2");
+
+        if constexpr (std::is_same_v<FFTType, juce::dsp::FFT>) {
+            thread_local std::map<size_t, std::shared_ptr<const FFTType>> threadFFTs{};
+            return findOrMakeFFT(threadFFTs, size);
+        }
+        else {
+            auto& cache = get();
+            const std::lock_guard<std::mutex> lock{cache.mutex};
+            return findOrMakeFFT(cache.ffts, size);
+        }
+    }
+
+    //Get a window table, scaled for an fft of the same size
+    static std::shared_ptr<const WindowTable> getScaledWindow(size_t size, FFTWindow windowType, FFTScaling scaling) {
+        auto& cache = get();
+        const std::lock_guard<std::mutex> lock{cache.mutex};
+
+        auto& window = cache.windows[{size, windowType, scaling}];
+        if (window == nullptr)
+            window = makeScaledWindow(size, windowType, scaling);
+        return window;
+    }
+
+private:
+    std::mutex mutex{};
+    std::map<size_t, std::shared_ptr<const FFTType>> ffts{};
+    std::map<std::tuple<size_t, FFTWindow, FFTScaling>, std::shared_ptr<const WindowTable>> windows{};
+
+    FFTTableCache() = default;
+
+    static FFTTableCache& get() {
+        static FFTTableCache cache{};
+        return cache;
+    }
+
+    static std::shared_ptr<const FFTType> findOrMakeFFT(std::map<size_t, std::shared_ptr<const FFTType>>& ffts, size_t size) {
+        auto& fft = ffts[size];
+        if (fft == nullptr)
+            fft = std::make_shared<const FFTType>(juce::roundToInt(std::log2(size)));
+        return fft;
+    }
+
+    static auto getWindowingMethod(FFTWindow windowType) noexcept {
+        using Method = typename juce::dsp::WindowingFunction<SampleType>::WindowingMethod;
+        switch (windowType) {
+            case FFTWindow::BlackmanHarris: return Method::blackmanHarris;
+            case FFTWindow::FlatTop:        return Method::flatTop;
+            default:                        return Method::hann;
+        }
+    }
+
+    static std::shared_ptr<const WindowTable> makeScaledWindow(size_t size, FFTWindow windowType, FFTScaling scaling) {
+        auto window = std::make_shared<WindowTable>();
+        auto& table = window->table;
+        table.resize(size);
+
+        //JUCE normalizes the window so its samples sum to its size, which corrects for its coherent gain
+        juce::dsp::WindowingFunction<SampleType>::fillWindowingTables(table.data(), size, getWindowingMethod(windowType));
+
+        //Measure the window's corrections in double, so they're accurate for large windows in float
+        double sum = 0.0, sumOfSquares = 0.0;
+        std::complex<double> halfBinResponse{};
+        for (size_t i = 0; i < size; ++i) {
+            const auto sample = static_cast<double>(table[i]);
+            sum += sample;
+            sumOfSquares += sample*sample;
+            halfBinResponse += std::polar(sample, -juce::MathConstants<double>::pi*static_cast<double>(i)/static_cast<double>(size));
+        }
+        window->equivalentNoiseBandwidth = static_cast<SampleType>(static_cast<double>(size)*sumOfSquares/(sum*sum));
+        window->scallopingGain = static_cast<SampleType>(std::abs(halfBinResponse)/sum);
+
+        //A window with a wider noise bandwidth lets more noise into each bin, so scale it back down to match a rectangular window
+        auto scale = SampleType{2}/static_cast<SampleType>(size);
+        if (scaling == FFTScaling::NoiseLevel)
+            scale /= std::sqrt(window->equivalentNoiseBandwidth);
+
+        for (auto&& sample : table)
+            sample *= scale;
+        return window;
+    }
+};
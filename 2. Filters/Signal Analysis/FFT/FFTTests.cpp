@@ -6,6 +6,8 @@
 #include "../../../Utilities/Random.h"
 #include "../../../Utilities/DecibelMatchers.h"
 
+#include <thread>
+
 constexpr auto numIterations = 1000000;
 
 //Test that the largest bin in the fft, when given a DC input, is 0
@@ -69,9 +71,300 @@ TEST_CASE ("FFT Noise Response", "[FFT]")
     //And test that each bin is close in value
     const auto loopSize = accumulator.getBuffer().size();
     for(size_t i = 1; i < loopSize-2; ++i) {
-        const auto current = std::pow (accumulator.getBuffer()[i].getAverage(), 2);
-        const auto next = std::pow (accumulator.getBuffer()[i + 1].getAverage(), 2);
+        const auto current = std::pow (accumulator.getBuffer()[i], 2);
+        const auto next = std::pow (accumulator.getBuffer()[i + 1], 2);
         const auto total = std::abs (current - next) / loopSize;
         REQUIRE (total < .001);
     }
-}
\ No newline at end of file
+}
+
+//Test that an overlapping fft outputs a frame every hop, and that each frame is the spectrum of the last FFTSize samples
+TEST_CASE ("FFT Overlapping Frames", "[FFT]")
+{
+    static constexpr size_t FFTSize = 256;
+    static constexpr size_t numSamples = FFTSize*8;
+    const size_t hopSize = GENERATE(FFTSize/4, FFTSize/2, FFTSize);
+
+    std::vector<float> noise(numSamples);
+    std::generate(noise.begin(), noise.end(), []{ return getBoundedRandom(-1.0f, 1.0f); });
+
+    FFTHelper<FFTSize> fft{hopSize};
+    size_t numFrames = 0;
+    for (size_t i = 0; i < numSamples; ++i) {
+        const auto result = fft.perform(noise[i]);
+        if (result == std::nullopt)
+            continue;
+
+        //The first frame is ready once the fft is full, and then there's another every hop
+        REQUIRE(i+1 == FFTSize+numFrames*hopSize);
+        ++numFrames;
+
+        //Push the same samples through an fft that doesn't overlap, and it should output the same frame
+        FFTHelper<FFTSize> referenceFFT{};
+        for (size_t j = i+1-FFTSize; j <= i; ++j)
+            referenceFFT.perform(noise[j]);
+
+        const auto& frame = result.value().get();
+        const auto& referenceFrame = referenceFFT.getFFTData();
+        for (size_t bin = 0; bin < FFTSize/2; ++bin)
+            REQUIRE(frame[bin] == Approx(referenceFrame[bin]).margin(1e-6));
+    }
+
+    REQUIRE(numFrames == (numSamples-FFTSize)/hopSize+1);
+}
+
+//Test that pushing blocks of samples outputs the same frames as pushing one sample at a time
+TEST_CASE ("FFT Block Push", "[FFT]")
+{
+    static constexpr size_t FFTSize = 256;
+    static constexpr size_t numSamples = FFTSize*8;
+    const size_t hopSize = GENERATE(FFTSize/4, FFTSize/2, FFTSize);
+    const size_t blockSize = GENERATE(1, 100, FFTSize, 1000);
+
+    std::vector<float> noise(numSamples);
+    std::generate(noise.begin(), noise.end(), []{ return getBoundedRandom(-1.0f, 1.0f); });
+
+    //Collect the frames from a sample by sample fft
+    FFTHelper<FFTSize> sampleFFT{hopSize};
+    std::vector<FFTHelper<FFTSize>::Frame> sampleFrames{};
+    for (const auto& sample : noise) {
+        const auto result = sampleFFT.perform(sample);
+        if (result != std::nullopt)
+            sampleFrames.push_back(result.value());
+    }
+
+    //And check the block fft outputs the same frames in the same order
+    FFTHelper<FFTSize> blockFFT{hopSize};
+    size_t numFrames = 0;
+    for (size_t start = 0; start < numSamples; start += blockSize) {
+        blockFFT.pushBlock(noise.data()+start, std::min(blockSize, numSamples-start), [&](const auto& frame) {
+            REQUIRE(numFrames < sampleFrames.size());
+            REQUIRE(frame == sampleFrames[numFrames]);
+            ++numFrames;
+        });
+    }
+
+    REQUIRE(numFrames == sampleFrames.size());
+}
+
+//Test that a double precision fft gives the same spectrum as a float one,
+// but matches a direct dft to double precision instead of float precision
+TEST_CASE ("FFT Double Precision", "[FFT]")
+{
+    static constexpr size_t FFTSize = 1024;
+    const auto frequency = GENERATE(10.0, 100.5, 300.25);
+
+    std::vector<double> input(FFTSize);
+    for (size_t i = 0; i < FFTSize; ++i)
+        input[i] = std::sin(juce::MathConstants<double>::twoPi*frequency*static_cast<double>(i)/FFTSize);
+
+    FFTHelper<FFTSize, float> floatFFT{};
+    FFTHelper<FFTSize, double> doubleFFT{};
+    for (const auto& in : input) {
+        floatFFT.perform(static_cast<float>(in));
+        doubleFFT.perform(in);
+    }
+
+    //Window and scale the input the same way the fft does, and take its dft the slow way in long double
+    std::vector<double> window(FFTSize);
+    juce::dsp::WindowingFunction<double>::fillWindowingTables(window.data(), FFTSize,
+                                                              juce::dsp::WindowingFunction<double>::WindowingMethod::hann);
+
+    const auto& floatData = floatFFT.getFFTData();
+    const auto& doubleData = doubleFFT.getFFTData();
+    for (size_t bin = 0; bin < FFTSize/2; ++bin) {
+        std::complex<long double> sum{};
+        for (size_t i = 0; i < FFTSize; ++i) {
+            const auto angle = -2.0L*juce::MathConstants<long double>::pi*static_cast<long double>((bin*i)%FFTSize)/FFTSize;
+            sum += std::polar(static_cast<long double>(input[i]*window[i]), angle);
+        }
+        const auto expected = static_cast<double>(std::abs(sum))*2.0/FFTSize;
+
+        REQUIRE(floatData[bin] == Approx(expected).margin(1e-5));
+        REQUIRE(doubleData[bin] == Approx(expected).margin(1e-12));
+    }
+}
+
+//Test that an fft with a runtime size gives the same frames as a fixed size one, and that large sizes can be used
+TEST_CASE ("FFT Runtime Size", "[FFT]")
+{
+    SECTION("Same frames as a fixed size fft") {
+        static constexpr size_t FFTSize = 512;
+        FFTHelper<FFTSize, double> fixedFFT{FFTSize/2};
+        FFTHelper<RuntimeFFTSize, double> runtimeFFT{FFTSize, FFTSize/2};
+        REQUIRE(runtimeFFT.getSize() == FFTSize);
+
+        for (size_t i = 0; i < FFTSize*4; ++i) {
+            const auto in = getBoundedRandom(-1.0, 1.0);
+            const auto fixedResult = fixedFFT.perform(in);
+            const auto runtimeResult = runtimeFFT.perform(in);
+
+            REQUIRE(fixedResult.has_value() == runtimeResult.has_value());
+            if (fixedResult != std::nullopt)
+                REQUIRE(fixedResult.value().get() == runtimeResult.value().get());
+        }
+    }
+
+    SECTION("Large fft") {
+        static constexpr size_t FFTSize = 65536;
+        const size_t sinBin = GENERATE(1, 1000, 30000);
+
+        FFTHelper<RuntimeFFTSize, double> fft{FFTSize, FFTSize};
+        for (size_t i = 0; i < FFTSize; ++i)
+            fft.perform(std::sin(juce::MathConstants<double>::twoPi*static_cast<double>((sinBin*i)%FFTSize)/FFTSize));
+
+        const auto& fftData = fft.getFFTData();
+        const auto largestBin = static_cast<size_t>(std::distance(fftData.begin(), std::max_element(fftData.begin(), fftData.begin()+FFTSize/2)));
+        REQUIRE(largestBin == sinBin);
+        //The window is normalized, so a full scale sin in the middle of a bin reads as 1
+        REQUIRE(fftData[sinBin] == Approx(1.0).epsilon(1e-3));
+    }
+
+    SECTION("Sizes that aren't a power of 2 are refused") {
+        const size_t FFTSize = GENERATE(0, 3, 1000);
+        REQUIRE_THROWS_AS((FFTHelper<RuntimeFFTSize, double>{FFTSize, 1}), std::invalid_argument);
+        REQUIRE_THROWS_AS(FFTTableCache<float>::getFFT(FFTSize), std::invalid_argument);
+    }
+}
+
+//Test that ffts and windows are built once per size and type, and that helpers sharing them work on separate threads
+TEMPLATE_TEST_CASE ("FFT Shared Tables", "[FFT]", float, double)
+{
+    using Tables = FFTTableCache<TestType>;
+    static constexpr size_t FFTSize = 1024;
+
+    SECTION("Tables are shared by size and type") {
+        REQUIRE(Tables::getFFT(FFTSize) == Tables::getFFT(FFTSize));
+        REQUIRE(Tables::getFFT(FFTSize) != Tables::getFFT(FFTSize*2));
+        REQUIRE(Tables::getScaledWindow(FFTSize, FFTWindow::Hann, FFTScaling::SinLevel)
+                == Tables::getScaledWindow(FFTSize, FFTWindow::Hann, FFTScaling::SinLevel));
+        REQUIRE(Tables::getScaledWindow(FFTSize, FFTWindow::Hann, FFTScaling::SinLevel)
+                != Tables::getScaledWindow(FFTSize, FFTWindow::FlatTop, FFTScaling::SinLevel));
+        REQUIRE(Tables::getScaledWindow(FFTSize, FFTWindow::Hann, FFTScaling::SinLevel)
+                != Tables::getScaledWindow(FFTSize, FFTWindow::Hann, FFTScaling::NoiseLevel));
+    }
+
+    SECTION("JUCE's ffts are kept per thread, and the radix 2 ffts are shared between threads") {
+        std::shared_ptr<const typename Tables::FFTType> otherThreadFFT{};
+        std::thread{[&] { otherThreadFFT = Tables::getFFT(FFTSize); }}.join();
+
+        if constexpr (std::is_same_v<typename Tables::FFTType, juce::dsp::FFT>)
+            REQUIRE(otherThreadFFT != Tables::getFFT(FFTSize));
+        else
+            REQUIRE(otherThreadFFT == Tables::getFFT(FFTSize));
+    }
+
+    SECTION("Helpers on different threads give the same frames") {
+        static constexpr size_t numThreads = 4;
+        std::vector<TestType> noise(FFTSize*16);
+        std::generate(noise.begin(), noise.end(), []{ return getBoundedRandom(TestType{-1}, TestType{1}); });
+
+        //Each thread makes its own helper, and sums every frame it outputs
+        std::array<std::vector<TestType>, numThreads> sums{};
+        std::vector<std::thread> threads{};
+        for (size_t i = 0; i < numThreads; ++i) {
+            threads.emplace_back([&, i] {
+                sums[i].resize(FFTSize*2);
+                FFTHelper<FFTSize, TestType> fft{FFTSize/4};
+                fft.pushBlock(noise.data(), noise.size(), [&](const auto& frame) {
+                    for (size_t bin = 0; bin < frame.size(); ++bin)
+                        sums[i][bin] += frame[bin];
+                });
+            });
+        }
+        for (auto&& thread : threads)
+            thread.join();
+
+        for (size_t i = 1; i < numThreads; ++i)
+            REQUIRE(sums[i] == sums[0]);
+    }
+}
+
+//Test that the flat top window reads the level of a sin from a single frame wherever it is between bins,
+// and that the other windows read it within their scalloping loss
+TEST_CASE ("FFT Window Sin Levels", "[FFT]")
+{
+    static constexpr size_t FFTSize = 256;
+    const auto frequencyInBins = GENERATE(take(20, random(10.0, 100.0)));
+    const auto amplitude = GENERATE(take(3, random(.01, 1.0)));
+    const auto windowType = GENERATE(FFTWindow::Hann, FFTWindow::BlackmanHarris, FFTWindow::FlatTop);
+
+    FFTHelper<FFTSize, double> fft{FFTSize, windowType};
+    for (size_t i = 0; i < FFTSize; ++i)
+        fft.perform(amplitude*std::sin(juce::MathConstants<double>::twoPi*frequencyInBins*static_cast<double>(i)/FFTSize));
+
+    const auto& fftData = fft.getFFTData();
+    const auto peakLevel = *std::max_element(fftData.begin(), fftData.begin()+FFTSize/2);
+    const auto error = Decibel<double>::convertAmplitudeToDecibel(peakLevel/amplitude);
+
+    if (windowType == FFTWindow::FlatTop)
+        REQUIRE(std::abs(error) < .05);
+    else
+        REQUIRE((error <= .05 && error >= Decibel<double>::convertAmplitudeToDecibel(fft.getScallopingGain())-.05));
+}
+
+//Test that the Blackman-Harris window keeps a sin that's as far from the middle of a bin as it can be out of distant bins
+TEST_CASE ("FFT Window Leakage", "[FFT]")
+{
+    static constexpr size_t FFTSize = 256;
+    static constexpr auto frequencyInBins = 40.5;
+
+    FFTHelper<FFTSize, double> fft{FFTSize, FFTWindow::BlackmanHarris};
+    for (size_t i = 0; i < FFTSize; ++i)
+        fft.perform(std::sin(juce::MathConstants<double>::twoPi*frequencyInBins*static_cast<double>(i)/FFTSize));
+
+    const auto& fftData = fft.getFFTData();
+    const auto peakLevel = std::max(fftData[40], fftData[41]);
+    for (size_t bin = 0; bin < FFTSize/2; ++bin)
+        if (bin+6 <= 40 || bin >= 41+6)
+            REQUIRE(Decibel<double>::convertAmplitudeToDecibel(fftData[bin]/peakLevel) < -90.0);
+}
+
+//Test that with noise level scaling, white noise reads as the same level through every window
+TEST_CASE ("FFT Window Noise Levels", "[FFT]")
+{
+    static constexpr size_t FFTSize = 256;
+    std::vector<double> noise(FFTSize*1000);
+    std::generate(noise.begin(), noise.end(), []{ return getBoundedRandom(-1.0, 1.0); });
+
+    //Average the power of every bin below nyquist over every frame
+    const auto measureNoisePower = [&](FFTWindow windowType) {
+        FFTHelper<FFTSize, double> fft{FFTSize/2, windowType, FFTScaling::NoiseLevel};
+        CumulativeAverage<double> power{};
+        fft.pushBlock(noise.data(), noise.size(), [&](const auto& frame) {
+            for (size_t bin = 1; bin < FFTSize/2; ++bin)
+                power.updateAverage(frame[bin]*frame[bin]);
+        });
+        return power.getAverage();
+    };
+
+    const auto hannPower = measureNoisePower(FFTWindow::Hann);
+    for (const auto windowType : {FFTWindow::BlackmanHarris, FFTWindow::FlatTop})
+        REQUIRE(std::abs(10.0*std::log10(measureNoisePower(windowType)/hannPower)) < .1);
+}
+
+//Test that the radix 2 fft's complex output matches a direct dft, so the phase of each bin can be read from it
+TEST_CASE ("FFT Real Transform", "[FFT]")
+{
+    static constexpr size_t FFTSize = 256;
+    const RadixTwoFFT<double> fft{8};
+
+    std::vector<double> input(FFTSize);
+    setRandomSeed(FFTSize);
+    std::generate(input.begin(), input.end(), []{ return getBoundedRandom(-1.0, 1.0); });
+
+    std::vector<double> data(FFTSize*2);
+    std::copy(input.begin(), input.end(), data.begin());
+    fft.performRealOnlyForwardTransform(data.data());
+
+    for (size_t bin = 0; bin < FFTSize; ++bin) {
+        std::complex<long double> sum{};
+        for (size_t i = 0; i < FFTSize; ++i) {
+            const auto angle = -2.0L*juce::MathConstants<long double>::pi*static_cast<long double>((bin*i)%FFTSize)/FFTSize;
+            sum += std::polar(static_cast<long double>(input[i]), angle);
+        }
+
+        REQUIRE(data[2*bin] == Approx(static_cast<double>(sum.real())).margin(1e-12));
+        REQUIRE(data[2*bin+1] == Approx(static_cast<double>(sum.imag())).margin(1e-12));
+    }
+}
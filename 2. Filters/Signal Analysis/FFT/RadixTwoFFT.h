@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <juce_core/juce_core.h>
+
+#include "../../../Utilities/AlignedAllocator.h"
+
+//A radix 2 fft that works in any floating point type
+//JUCE's fft only takes floats, so this lets double precision analysis stay in double the whole way through
+//It has the same interface as juce::dsp::FFT's frequency only, real only and complex transforms, so FFTHelper can use either
+template<typename SampleType>
+class RadixTwoFFT
+{
+public:
+    using Complex = std::complex<SampleType>;
+
+    //Make an fft with a size of 2^order
+    // The bit reversed order of the input and the twiddle factors are worked out up front, so transforms don't call sin or cos
+    explicit RadixTwoFFT(int order) : size(size_t{1} << order) {
+        for (size_t i = 0; i < size; ++i) {
+            size_t reversed = 0;
+            for (auto bit = 0; bit < order; ++bit)
+                reversed |= ((i >> bit) & 1) << (order-1-bit);
+            bitReversedIndices[i] = reversed;
+        }
+
+        //The twiddles are calculated in double so the float version doesn't lose any accuracy
+        for (size_t i = 0; i < size/2; ++i)
+            twiddles[i] = Complex(std::polar(1.0, -juce::MathConstants<double>::twoPi*static_cast<double>(i)/static_cast<double>(size)));
+    }
+
+    int getSize() const noexcept { return static_cast<int>(size); }
+
+    //Takes 2*size values, with the input in the first half,
+    // and replaces the first half with the magnitude of each bin and the second half with 0, like JUCE's fft
+    void performFrequencyOnlyForwardTransform(SampleType* inputOutputData) const noexcept {
+        performRealOnlyForwardTransform(inputOutputData);
+
+        //Bin i's magnitude only writes over the complex values of bins that have already been read
+        const auto* data = reinterpret_cast<const Complex*>(inputOutputData);
+        for (size_t i = 0; i < size; ++i)
+            inputOutputData[i] = std::abs(data[i]);
+        std::fill(inputOutputData+size, inputOutputData+size*2, SampleType{0});
+    }
+
+    //Takes 2*size values, with the input in the first half,
+    // and replaces them with every bin as interleaved real and imaginary parts, like JUCE's real only transform
+    //The transform is done in place, using the whole buffer to hold size complex values,
+    // so it doesn't change the fft and one fft can be shared between threads
+    void performRealOnlyForwardTransform(SampleType* inputOutputData) const noexcept {
+        //Spread the real input out into complex values, working backwards so no input is written over before it's read
+        auto* data = reinterpret_cast<Complex*>(inputOutputData);
+        for (size_t i = size; i-- > 0;) {
+            inputOutputData[2*i+1] = SampleType{0};
+            inputOutputData[2*i] = inputOutputData[i];
+        }
+
+        transform(data);
+    }
+
+    //Transform size complex values, like JUCE's complex transform
+    // The inverse transform is scaled by 1/size, so an inverse transform undoes a forward one
+    //input and output can be the same buffer
+    void perform(const Complex* input, Complex* output, bool inverse) const noexcept {
+        //The inverse transform is the forward transform of the conjugate, conjugated again
+        if (inverse)
+            std::transform(input, input+size, output, [](const auto& value) { return std::conj(value); });
+        else if (input != output)
+            std::copy(input, input+size, output);
+
+        transform(output);
+
+        if (inverse) {
+            const auto scale = SampleType{1}/static_cast<SampleType>(size);
+            std::transform(output, output+size, output, [scale](const auto& value) { return std::conj(value)*scale; });
+        }
+    }
+
+private:
+    size_t size;
+    std::vector<size_t> bitReversedIndices = std::vector<size_t>(size);
+    AlignedVector<Complex> twiddles = AlignedVector<Complex>(size/2);
+
+    //Transform size complex values in place
+    void transform(Complex* data) const noexcept {
+        for (size_t i = 0; i < size; ++i)
+            if (i < bitReversedIndices[i])
+                std::swap(data[i], data[bitReversedIndices[i]]);
+
+        //Each pass combines pairs of transforms half its length into one, starting with transforms of a single point
+        for (size_t length = 2; length <= size; length *= 2) {
+            const auto halfLength = length/2;
+            const auto twiddleStride = size/length;
+            for (size_t start = 0; start < size; start += length) {
+                for (size_t i = 0; i < halfLength; ++i) {
+                    const auto even = data[start+i];
+                    const auto odd = data[start+i+halfLength]*twiddles[i*twiddleStride];
+                    data[start+i] = even+odd;
+                    data[start+i+halfLength] = even-odd;
+                }
+            }
+        }
+    }
+};
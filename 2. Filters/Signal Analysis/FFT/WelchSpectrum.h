@@ -0,0 +1,95 @@
+#pragma once
+
+#include <limits>
+
+#include "FFT.h"
+#include "../Signal Analyzers.h"
+
+//Estimates the power spectrum of a signal with Welch's method:
+// the signal is split into overlapping, windowed segments, and the power of each bin is averaged over every segment
+//Averaging power rather than magnitude gives an unbiased estimate of the power in each bin,
+// and the frames are scaled by the window's equivalent noise bandwidth, so the level of noise doesn't depend on the window
+//Each bin's estimate has a known spread for noise-like input, which getRelativeError reports,
+// so a caller can stop pushing samples as soon as the estimate is as accurate as it needs to be
+//The default 50% overlap with a Hann window gets nearly all of the accuracy that overlapping can give
+template<size_t FFTSize, typename SampleType = float>
+class WelchSpectrum
+{
+public:
+    static constexpr size_t NumBins = FFTSize/2;
+    static constexpr FFTWindow DefaultWindow = FFTWindow::Hann;
+    static constexpr size_t DefaultHopSize = FFTSize/2;
+
+    explicit WelchSpectrum(FFTWindow windowType = DefaultWindow, size_t hopSize = DefaultHopSize)
+        : fft(hopSize, windowType, FFTScaling::NoiseLevel) {
+        calculateOverlapCorrelations(windowType);
+    }
+
+    //Push a block of samples, adding each segment it completes to the estimate
+    template<typename InputType>
+    void pushBlock(const InputType* samples, size_t numSamples) {
+        fft.pushBlock(samples, numSamples, [this](const auto& frame) {
+            for (size_t i = 0; i < NumBins; ++i)
+                segmentPower[i] = frame[i]*frame[i];
+            powerAverager.perform(segmentPower);
+        });
+    }
+
+    void reset() {
+        fft.reset();
+        powerAverager.reset();
+    }
+
+    //The average power of each bin below nyquist
+    constexpr const auto& getPowerSpectrum() const noexcept { return powerAverager.getBuffer(); }
+
+    //The square root of each bin's average power, which can be compared like the level of a magnitude spectrum
+    auto getLevelSpectrum() const {
+        AlignedVector<SampleType> levels(NumBins);
+        std::transform(getPowerSpectrum().begin(), getPowerSpectrum().end(), levels.begin(),
+                       [](const auto& power) { return std::sqrt(power); });
+        return levels;
+    }
+
+    constexpr auto getNumSegments() const noexcept { return powerAverager.getCount(); }
+
+    //The standard deviation of each bin's power estimate, relative to the power itself, for noise-like input
+    // One segment's power is as likely to be off by its own size, and averaging K independent segments divides that by sqrt(K).
+    // Overlapping segments aren't independent, so each pair that overlaps adds the square of the window's correlation at that offset
+    //The dc and nyquist bins are real, and spread by sqrt(2) more than this
+    SampleType getRelativeError() const noexcept {
+        const auto numSegments = getNumSegments();
+        if (numSegments == 0)
+            return std::numeric_limits<SampleType>::infinity();
+
+        const auto k = static_cast<double>(numSegments);
+        auto varianceScale = 1.0;
+        for (size_t offset = 1; offset < std::min(numSegments, overlapCorrelations.size()+1); ++offset)
+            varianceScale += 2.0*(1.0-static_cast<double>(offset)/k)*overlapCorrelations[offset-1]*overlapCorrelations[offset-1];
+        return static_cast<SampleType>(std::sqrt(varianceScale/k));
+    }
+
+private:
+    FFTHelper<FFTSize, SampleType> fft;
+    AlignedVector<SampleType> segmentPower = AlignedVector<SampleType>(NumBins);
+    BufferAverager<SampleType, NumBins> powerAverager{};
+
+    //The correlation between the window and itself, offset by each multiple of the hop that still overlaps
+    std::vector<double> overlapCorrelations{};
+
+    void calculateOverlapCorrelations(FFTWindow windowType) {
+        const auto& window = FFTTableCache<SampleType>::getScaledWindow(FFTSize, windowType, FFTScaling::NoiseLevel)->table;
+        const auto hopSize = fft.getHopSize();
+
+        double sumOfSquares = 0.0;
+        for (const auto& sample : window)
+            sumOfSquares += static_cast<double>(sample)*static_cast<double>(sample);
+
+        for (auto offset = hopSize; offset < FFTSize; offset += hopSize) {
+            double sum = 0.0;
+            for (size_t i = 0; i+offset < FFTSize; ++i)
+                sum += static_cast<double>(window[i])*static_cast<double>(window[i+offset]);
+            overlapCorrelations.push_back(sum/sumOfSquares);
+        }
+    }
+};
@@ -0,0 +1,88 @@
+#include <catch2/catch.hpp>
+
+#include "WelchSpectrum.h"
+
+#include "../../../Utilities/Random.h"
+
+#include <numeric>
+
+//Test that white noise has the same power in every bin, whichever window is used
+// Uniform noise between -1 and 1 has a power of 1/3, and the fft's 2/N scaling makes each bin's share 4/(3N)
+TEMPLATE_TEST_CASE ("Welch Spectrum Noise Power", "[Welch Spectrum]", float, double)
+{
+    static constexpr size_t FFTSize = 256;
+    const auto windowType = GENERATE(FFTWindow::Hann, FFTWindow::BlackmanHarris, FFTWindow::FlatTop);
+
+    std::vector<TestType> noise(FFTSize*2000);
+    std::generate(noise.begin(), noise.end(), []{ return getBoundedRandom(TestType{-1}, TestType{1}); });
+
+    WelchSpectrum<FFTSize, TestType> spectrum{windowType};
+    spectrum.pushBlock(noise.data(), noise.size());
+
+    const auto& power = spectrum.getPowerSpectrum();
+    const auto averagePower = std::accumulate(power.begin()+1, power.end(), 0.0)/static_cast<double>(power.size()-1);
+    REQUIRE(averagePower == Approx(4.0/(3.0*FFTSize)).epsilon(.02));
+
+    const auto levels = spectrum.getLevelSpectrum();
+    for (size_t i = 0; i < levels.size(); ++i)
+        REQUIRE(levels[i] == Approx(std::sqrt(power[i])));
+}
+
+//Test that the relative error the spectrum reports matches the spread of its estimates over many runs
+TEST_CASE ("Welch Spectrum Relative Error", "[Welch Spectrum]")
+{
+    static constexpr size_t FFTSize = 128;
+    static constexpr size_t numRuns = 200;
+    const size_t hopSize = GENERATE(FFTSize/4, FFTSize/2, FFTSize);
+    const size_t numSegments = GENERATE(4, 32);
+
+    //Collect the power of each bin in every run, skipping dc and nyquist which spread further
+    std::vector<double> noise(FFTSize+(numSegments-1)*hopSize);
+    std::vector<double> estimates{};
+    double reportedError = 0.0;
+    for (size_t run = 0; run < numRuns; ++run) {
+        std::generate(noise.begin(), noise.end(), []{ return getBoundedRandom(-1.0, 1.0); });
+
+        WelchSpectrum<FFTSize, double> spectrum{FFTWindow::Hann, hopSize};
+        spectrum.pushBlock(noise.data(), noise.size());
+        REQUIRE(spectrum.getNumSegments() == numSegments);
+
+        const auto& power = spectrum.getPowerSpectrum();
+        estimates.insert(estimates.end(), power.begin()+1, power.end());
+        reportedError = spectrum.getRelativeError();
+    }
+
+    const auto mean = std::accumulate(estimates.begin(), estimates.end(), 0.0)/static_cast<double>(estimates.size());
+    double variance = 0.0;
+    for (const auto& estimate : estimates)
+        variance += (estimate-mean)*(estimate-mean);
+    variance /= static_cast<double>(estimates.size()-1);
+
+    REQUIRE(std::sqrt(variance)/mean == Approx(reportedError).epsilon(.1));
+}
+
+//Test that the error falls as segments are added, and that it can be used to stop early
+TEST_CASE ("Welch Spectrum Stops When Settled", "[Welch Spectrum]")
+{
+    static constexpr size_t FFTSize = 1024;
+    static constexpr size_t blockSize = 4096;
+    const auto targetError = GENERATE(.2, .1, .05);
+
+    WelchSpectrum<FFTSize, double> spectrum{};
+    REQUIRE(spectrum.getRelativeError() == std::numeric_limits<double>::infinity());
+
+    std::vector<double> block(blockSize);
+    auto previousError = spectrum.getRelativeError();
+    while (spectrum.getRelativeError() > targetError) {
+        std::generate(block.begin(), block.end(), []{ return getBoundedRandom(-1.0, 1.0); });
+        spectrum.pushBlock(block.data(), block.size());
+
+        REQUIRE(spectrum.getRelativeError() < previousError);
+        previousError = spectrum.getRelativeError();
+    }
+
+    //Independent segments would need 1/error^2 of them, and the Hann window's overlap only adds a few percent more
+    const auto independentSegments = 1.0/(targetError*targetError);
+    REQUIRE(static_cast<double>(spectrum.getNumSegments()) > independentSegments);
+    REQUIRE(static_cast<double>(spectrum.getNumSegments()) < independentSegments*1.1+blockSize/(FFTSize/2));
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <juce_core/juce_core.h>
+
+#include "BiquadResponse.h"
+#include "FFT/FFTTableCache.h"
+#include "../../Utilities/AlignedAllocator.h"
+
+//How many samples in a row have to be below the decay threshold for an impulse response to count as having died away
+//A response can cross zero on its way down, so a single quiet sample isn't enough.
+// This is longer than half the period of anything the filter tests ring at, so a ringing response always has a peak inside it
+constexpr size_t impulseDecayLength = 1024;
+
+//Capture the impulse response of a linear, time invariant processor, like one of JUCE's IIR filters
+//The processor is reset, then given a single sample at 1 followed by silence,
+// until its output stays below decayThreshold for impulseDecayLength samples, or maxLength samples have been captured
+//The quiet samples at the end are left off, so the response is only as long as it needs to be
+template<typename SampleType, typename Processor>
+auto measureImpulseResponse(Processor& processor, size_t maxLength, SampleType decayThreshold) {
+    processor.reset();
+
+    AlignedVector<SampleType> impulseResponse{};
+    size_t numQuietSamples = 0;
+    for (size_t i = 0; i < maxLength && numQuietSamples < impulseDecayLength; ++i) {
+        const auto sample = processor.processSample(i == 0 ? SampleType{1} : SampleType{0});
+        impulseResponse.push_back(sample);
+        numQuietSamples = std::abs(sample) < decayThreshold ? numQuietSamples+1 : 0;
+    }
+
+    impulseResponse.resize(std::max(impulseResponse.size()-numQuietSamples, size_t{1}));
+    return impulseResponse;
+}
+
+//Get the response at every bin below nyquist of an fft of fftSize from an impulse response
+//The response is zero padded, and transformed in one go, which gives the exact response of whatever was captured.
+// Responses longer than the fft are transformed with a larger fft, and every bin that lines up with one of fftSize's is kept,
+// so a long response isn't cut short
+//The group delay comes from the transform of the response multiplied by time, so it doesn't have to be unwrapped from the phase
+//The transforms are done in double, with the fft shared with every other double fft of the same size
+//fftSize has to be a power of 2, or this throws std::invalid_argument
+template<typename SampleType, typename ImpulseResponse>
+auto getImpulseResponseSpectrum(const ImpulseResponse& impulseResponse, size_t fftSize) {
+    //JUCE counts 0 as a power of 2
+    if (fftSize == 0 || !juce::isPowerOfTwo(fftSize))
+        throw std::invalid_argument("An impulse response's spectrum has to be measured with a power of 2 fft");
+
+    auto transformSize = fftSize;
+    while (transformSize < static_cast<size_t>(impulseResponse.size()))
+        transformSize *= 2;
+    const auto binStride = transformSize/fftSize;
+
+    //Each buffer holds transformSize complex values, with the zero padded response in its first half
+    AlignedVector<double> spectrum(transformSize*2), delayedSpectrum(transformSize*2);
+    for (size_t i = 0; i < static_cast<size_t>(impulseResponse.size()); ++i) {
+        spectrum[i] = static_cast<double>(impulseResponse[i]);
+        delayedSpectrum[i] = static_cast<double>(i)*spectrum[i];
+    }
+
+    const auto fft = FFTTableCache<double>::getFFT(transformSize);
+    fft->performRealOnlyForwardTransform(spectrum.data());
+    fft->performRealOnlyForwardTransform(delayedSpectrum.data());
+
+    const auto numBins = fftSize/2;
+    FrequencyResponse<SampleType> response{AlignedVector<SampleType>(numBins),
+                                           AlignedVector<SampleType>(numBins),
+                                           AlignedVector<SampleType>(numBins)};
+    for (size_t i = 0; i < numBins; ++i) {
+        const auto bin = std::complex<double>{spectrum[2*i*binStride], spectrum[2*i*binStride+1]};
+        const auto delayedBin = std::complex<double>{delayedSpectrum[2*i*binStride], delayedSpectrum[2*i*binStride+1]};
+
+        response.magnitudes[i] = static_cast<SampleType>(std::abs(bin));
+        response.phases[i] = static_cast<SampleType>(std::arg(bin));
+        //At a zero of the response the group delay isn't defined, so it's given as no delay
+        response.groupDelays[i] = std::norm(bin) > 0.0 ? static_cast<SampleType>((delayedBin/bin).real()) : SampleType{0};
+    }
+    return response;
+}
+
+//Get the magnitude of an impulse response's spectrum at any frequency, rather than only at the bins of an fft
+//The response is summed up directly in double, which takes a pass over the whole response for every frequency
+template<typename SampleType, typename ImpulseResponse>
+auto getImpulseResponseMagnitude(const ImpulseResponse& impulseResponse, SampleType frequency, SampleType sampleRate) {
+    const auto radiansPerSample = juce::MathConstants<double>::twoPi*static_cast<double>(frequency)/static_cast<double>(sampleRate);
+
+    auto bin = std::complex<double>{0.0};
+    for (size_t i = 0; i < static_cast<size_t>(impulseResponse.size()); ++i)
+        bin += static_cast<double>(impulseResponse[i])*std::polar(1.0, -radiansPerSample*static_cast<double>(i));
+    return static_cast<SampleType>(std::abs(bin));
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch.hpp>
+
+#include "ImpulseResponse.h"
+#include "BiquadResponse.h"
+
+#include <juce_dsp/juce_dsp.h>
+
+//A one pole filter, whose impulse response is each power of the pole in turn
+template<typename SampleType>
+struct OnePole
+{
+    SampleType pole{}, state{};
+
+    void reset() noexcept { state = SampleType{0}; }
+    SampleType processSample(SampleType sample) noexcept { return state = sample+pole*state; }
+};
+
+//Test that the response stops once it has decayed, and that maxLength cuts off one that decays too slowly
+TEMPLATE_TEST_CASE ("Impulse Response Decay", "[Impulse Response]", float, double)
+{
+    //.5^20 is the first power of .5 below 1e-6
+    OnePole<TestType> fastDecay{TestType{.5}};
+    const auto fastResponse = measureImpulseResponse(fastDecay, 100000, TestType{1e-6});
+    REQUIRE(fastResponse.size() == 20);
+    for (size_t i = 0; i < fastResponse.size(); ++i)
+        REQUIRE(fastResponse[i] == Approx(std::pow(.5, static_cast<double>(i))));
+
+    //Measuring again resets the filter first, so it gives the same response
+    REQUIRE(measureImpulseResponse(fastDecay, 100000, TestType{1e-6}) == fastResponse);
+
+    OnePole<TestType> slowDecay{TestType{.9999}};
+    REQUIRE(measureImpulseResponse(slowDecay, 5000, TestType{1e-6}).size() == 5000);
+}
+
+//Test that the spectrum of a biquad's impulse response matches the response worked out from its coefficients
+TEMPLATE_TEST_CASE ("Impulse Response Spectrum Matches Biquad Response", "[Impulse Response]", float, double)
+{
+    using Coefficients = juce::dsp::IIR::Coefficients<TestType>;
+    constexpr size_t fftSize = 1024;
+    constexpr auto sampleRate = TestType{44100};
+    const auto cutoff = GENERATE(TestType{50}, TestType{1000}, TestType{15000});
+    const auto q = TestType{.7071};
+
+    const auto frequencies = makeFrequencyGrid<TestType>(fftSize/2, sampleRate);
+
+    //The group delay weights each sample of the response by its time, so the response has to be captured well into its tail
+    //A float filter's rounding stops its response decaying as far, and adds up over the response of a filter with a low cutoff
+    const auto decayThreshold = std::is_same_v<TestType, float> ? TestType{1e-7} : TestType{1e-10};
+    const auto tolerance = std::is_same_v<TestType, float> ? 1e-2 : 1e-4;
+
+    for (const auto& coefficients : {Coefficients::makeLowPass(sampleRate, cutoff, q),
+                                     Coefficients::makeHighPass(sampleRate, cutoff, q),
+                                     Coefficients::makeBandPass(sampleRate, cutoff, q),
+                                     Coefficients::makeAllPass(sampleRate, cutoff, q),
+                                     Coefficients::makePeakFilter(sampleRate, cutoff, q, TestType{4})}) {
+        juce::dsp::IIR::Filter<TestType> filter{coefficients};
+        const auto impulseResponse = measureImpulseResponse(filter, 100000, decayThreshold);
+        const auto measured = getImpulseResponseSpectrum<TestType>(impulseResponse, fftSize);
+        const auto expected = BiquadResponse<TestType>::fromCoefficients(*coefficients).getResponse(frequencies, sampleRate);
+
+        REQUIRE(measured.magnitudes.size() == fftSize/2);
+        for (size_t i = 1; i < fftSize/2; ++i) {
+            REQUIRE(measured.magnitudes[i] == Approx(expected.magnitudes[i]).epsilon(tolerance).margin(1e-5));
+
+            //The phase and group delay of bins the filter has all but removed are mostly the cut off tail of the response
+            if (expected.magnitudes[i] > TestType{1e-2}) {
+                REQUIRE(std::abs(std::polar(1.0, static_cast<double>(measured.phases[i]))
+                                 -std::polar(1.0, static_cast<double>(expected.phases[i]))) < tolerance);
+
+                //The rounding in a float filter's response is weighted by time too, which leaves its group delay several percent out
+                if constexpr (std::is_same_v<TestType, double>)
+                    REQUIRE(measured.groupDelays[i] == Approx(expected.groupDelays[i]).epsilon(1e-3).margin(1e-2));
+            }
+        }
+    }
+}
+
+//Test that a response longer than the fft is transformed whole, rather than cut short
+TEST_CASE ("Impulse Response Longer Than FFT", "[Impulse Response]")
+{
+    constexpr size_t fftSize = 64;
+    OnePole<double> filter{.999};
+    const auto impulseResponse = measureImpulseResponse(filter, 100000, 1e-9);
+    REQUIRE(impulseResponse.size() > fftSize);
+
+    const auto response = getImpulseResponseSpectrum<double>(impulseResponse, fftSize);
+    for (size_t i = 0; i < fftSize/2; ++i) {
+        const auto bin = 1.0/(1.0-std::polar(.999, -juce::MathConstants<double>::twoPi*static_cast<double>(i)/fftSize));
+        REQUIRE(response.magnitudes[i] == Approx(std::abs(bin)).epsilon(1e-6));
+        REQUIRE(response.phases[i] == Approx(std::arg(bin)).margin(1e-6));
+    }
+}
+
+//Test that an fft size that isn't a power of 2 is refused, rather than transformed with the wrong size
+TEST_CASE ("Impulse Response Spectrum Size", "[Impulse Response]")
+{
+    const std::vector<double> impulse{1.0};
+    const size_t fftSize = GENERATE(0, 48, 1000);
+    REQUIRE_THROWS_AS(getImpulseResponseSpectrum<double>(impulse, fftSize), std::invalid_argument);
+}
+
+//Test that the magnitude at any frequency matches the response worked out from the coefficients, including between bins
+TEMPLATE_TEST_CASE ("Impulse Response Magnitude At Any Frequency", "[Impulse Response]", float, double)
+{
+    using Coefficients = juce::dsp::IIR::Coefficients<TestType>;
+    constexpr auto sampleRate = TestType{44100};
+    const auto cutoff = GENERATE(TestType{50}, TestType{1000}, TestType{15000});
+    const auto q = TestType{.7071};
+
+    for (const auto& coefficients : {Coefficients::makeLowPass(sampleRate, cutoff, q),
+                                     Coefficients::makeHighPass(sampleRate, cutoff, q),
+                                     Coefficients::makePeakFilter(sampleRate, cutoff, q, TestType{4})}) {
+        juce::dsp::IIR::Filter<TestType> filter{coefficients};
+        const auto impulseResponse = measureImpulseResponse(filter, 100000, TestType{1e-7});
+        const auto expected = BiquadResponse<TestType>::fromCoefficients(*coefficients);
+
+        for (const auto frequency : {cutoff, cutoff*TestType{.37}, cutoff*TestType{1.41}}) {
+            if (frequency >= sampleRate/TestType{2})
+                continue;
+
+            REQUIRE(getImpulseResponseMagnitude(impulseResponse, frequency, sampleRate)
+                    == Approx(expected.getMagnitude(frequency, sampleRate)).epsilon(1e-2).margin(1e-5));
+        }
+    }
+}
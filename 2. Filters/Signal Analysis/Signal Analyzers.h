@@ -1,6 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <limits>
+#include <juce_core/juce_core.h>
+
+#include "../../Utilities/AlignedAllocator.h"
 
 //A simple class for taking the running average of a stream of numbers
 //Useful when you don't know what the size of the data set will be
@@ -80,33 +88,124 @@ private:
     Type runningTotal{};
 };
 
+//A class that measures the amplitude and phase of a single frequency in an incoming stream, using the Goertzel algorithm
+//This is one bin of a dft that's updated a sample at a time, so the level of a known tone can be measured
+// without an fft, and without anything at other frequencies getting in the way
+//A pure tone is measured exactly over any number of samples, but other frequencies leak in the least
+// when the measurement spans a whole number of the tone's periods, which getWholePeriodLength gives
+//The state is kept in double, as the recursion loses too much precision in float at low frequencies
+template<typename Type>
+class GoertzelAnalyzer
+{
+public:
+    void setFrequency(Type frequency, Type sampleRate) noexcept {
+        angularFrequency = juce::MathConstants<double>::twoPi*static_cast<double>(frequency)/static_cast<double>(sampleRate);
+        coefficient = 2.0*std::cos(angularFrequency);
+        reset();
+    }
+
+    void update(Type input) noexcept {
+        const auto newState = static_cast<double>(input)+coefficient*state-previousState;
+        previousState = state;
+        state = newState;
+        ++counter;
+    }
+
+    //The amplitude of the tone
+    Type getAmplitude() const noexcept { return static_cast<Type>(std::abs(getComplexAmplitude())); }
+
+    //The phase of the tone in radians, where a cos that starts at the first sample measured has a phase of 0
+    Type getPhase() const noexcept { return static_cast<Type>(std::arg(getComplexAmplitude())); }
+
+    constexpr auto getNumSamples() const noexcept { return counter; }
+
+    void reset() noexcept {
+        state = 0;
+        previousState = 0;
+        counter = 0;
+    }
+
+    //The number of samples closest to a whole number of periods of a frequency that's at least minimumLength long
+    // Frequencies with periods too long to measure in maximumLength samples just get maximumLength
+    static size_t getWholePeriodLength(Type frequency, Type sampleRate, size_t minimumLength, size_t maximumLength) noexcept {
+        const auto period = static_cast<double>(sampleRate)/static_cast<double>(frequency);
+        const auto length = std::round(std::ceil(static_cast<double>(minimumLength)/period)*period);
+        if (!(length < static_cast<double>(maximumLength)))
+            return maximumLength;
+        return std::max(minimumLength, static_cast<size_t>(length));
+    }
+
+private:
+    double angularFrequency{0};
+    double coefficient{2};
+    double state{0}, previousState{0};
+    size_t counter{0};
+
+    std::complex<double> getComplexAmplitude() const noexcept {
+        if (counter == 0)
+            return {};
+
+        //Finish the recursion to get the bin, with its phase taken back to the first sample
+        const auto numSamples = static_cast<double>(counter);
+        const auto bin = std::polar(1.0, -angularFrequency*(numSamples-1.0))
+                       * (state-std::polar(1.0, -angularFrequency)*previousState);
+
+        //A real tone is a pair of frequencies, w and -w, and some of -w leaks into the bin unless it's measured over whole periods
+        // The leak is the sum of e^-2jwn over the samples measured, so it can be solved for and taken back out
+        //At dc and nyquist the two are the same frequency and can't be separated, so the bin is just the level
+        const auto sinOfFrequency = std::sin(angularFrequency);
+        if (std::abs(sinOfFrequency) < std::numeric_limits<float>::epsilon())
+            return bin/numSamples;
+
+        const auto leakage = std::polar(std::sin(angularFrequency*numSamples)/sinOfFrequency, -angularFrequency*(numSamples-1.0));
+        const auto determinant = numSamples*numSamples-std::norm(leakage);
+        if (determinant < numSamples*numSamples*std::numeric_limits<float>::epsilon())
+            return bin/numSamples;
+
+        return 2.0*(bin*numSamples-std::conj(bin)*leakage)/determinant;
+    }
+};
+
 //A struct that keeps a running average of each element in a collection
 //Useful to average the level of an fft's bins over multiple frames, for example
+//The averages are kept in one contiguous array, and share a single count of how many collections have been averaged,
+// so each update is one reciprocal for the whole collection, and a multiply-add per element that can be vectorized
+//Only the first BufferSize elements of each collection are averaged, so an fft's frame can be averaged over just the bins below nyquist
 template<typename FloatType, size_t BufferSize>
 class BufferAverager
 {
 public:
     static constexpr auto Size = BufferSize;
 
+    //Collections in a reference wrapper, like the frames FFTHelper returns, are averaged the same as any other
     template<typename Collection>
-    auto perform(const Collection& collection) noexcept {
-        for(auto i = 0; i < collection.get().size(); ++i)
-            buffer[i].updateAverage(collection.get()[i]);
+    auto perform(const std::reference_wrapper<Collection>& collection) noexcept {
+        perform(collection.get());
     }
 
-    template<typename T>
-    auto perform(const std::array<T, Size>& collection) noexcept {
-        for(auto i = 0; i < collection.size(); ++i)
-            buffer[i].updateAverage(collection[i]);
+    template<typename Collection>
+    auto perform(const Collection& collection) noexcept {
+        const auto reciprocalCount = FloatType{1}/static_cast<FloatType>(++count);
+        const auto numElements = std::min(Size, static_cast<size_t>(collection.size()));
+
+        const auto* input = collection.data();
+        auto* averages = buffer.data();
+        for (size_t i = 0; i < numElements; ++i)
+            averages[i] += (static_cast<FloatType>(input[i])-averages[i])*reciprocalCount;
     }
 
     void reset() noexcept {
-        for(auto&& average : buffer)
-            average.reset();
+        std::fill(buffer.begin(), buffer.end(), FloatType{0});
+        count = 0;
     }
 
+    //The average of each element
     constexpr const auto& getBuffer() const noexcept { return buffer; }
 
+    //How many collections have been averaged since the last reset
+    constexpr auto getCount() const noexcept { return count; }
+
 private:
-    std::vector<CumulativeAverage<FloatType>> buffer{Size};
+    AlignedVector<FloatType> buffer = AlignedVector<FloatType>(Size);
+    size_t count{0};
 };
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "Signal Analyzers.h"
 
+#include <numeric>
+
 TEST_CASE ("Cumulative Average", "[Buffer Accumulator]")
 {
     BufferAverager<double, 10> accumulators{};
@@ -9,25 +11,25 @@ TEST_CASE ("Cumulative Average", "[Buffer Accumulator]")
     std::fill(buf.begin(), buf.end(), 1.0);
 
     accumulators.perform(buf);
-    for(auto&& cma : accumulators.getBuffer())
-        REQUIRE(cma.getAverage() == 1);
+    for(auto&& average : accumulators.getBuffer())
+        REQUIRE(average == 1);
 
     std::fill(buf.begin(), buf.end(), 2.0);
     accumulators.perform(buf);
-    for(auto&& cma : accumulators.getBuffer())
-        REQUIRE(cma.getAverage() == 1.5);
+    for(auto&& average : accumulators.getBuffer())
+        REQUIRE(average == 1.5);
 
     std::fill(buf.begin(), buf.end(), 3.0);
     accumulators.perform(buf);
-    for(auto&& cma : accumulators.getBuffer())
-        REQUIRE(cma.getAverage() == 2);
+    for(auto&& average : accumulators.getBuffer())
+        REQUIRE(average == 2);
     accumulators.reset();
 
-    for(auto&& cma : accumulators.getBuffer())
-        REQUIRE(cma.getAverage() == 0);
+    for(auto&& average : accumulators.getBuffer())
+        REQUIRE(average == 0);
     accumulators.perform(buf);
-    for(auto&& cma : accumulators.getBuffer())
-        REQUIRE(cma.getAverage() == 3);
+    for(auto&& average : accumulators.getBuffer())
+        REQUIRE(average == 3);
 //    REQUIRE(average.getAverage() == 0);
 }
 
@@ -39,4 +41,68 @@ TEST_CASE ("Cumulative Buffer Average", "[Buffer Accumulator]")
     REQUIRE(average.updateAverage(3) == 2);
     average.reset();
     REQUIRE(average.getAverage() == 0);
-}
\ No newline at end of file
+}
+
+TEST_CASE ("Buffer Average Size", "[Buffer Accumulator]")
+{
+    //Only the first four elements of each collection are averaged
+    BufferAverager<double, 4> accumulators{};
+    std::vector<double> buf(10);
+
+    for (auto i = 0; i < 5; ++i) {
+        std::iota(buf.begin(), buf.end(), static_cast<double>(i));
+        accumulators.perform(buf);
+    }
+
+    REQUIRE(accumulators.getCount() == 5);
+    REQUIRE(accumulators.getBuffer().size() == 4);
+    for (size_t i = 0; i < accumulators.getBuffer().size(); ++i)
+        REQUIRE(accumulators.getBuffer()[i] == Approx(static_cast<double>(i)+2.0));
+}
+
+//Test that a tone's amplitude and phase are measured exactly, whether or not the measurement spans whole periods
+TEMPLATE_TEST_CASE ("Goertzel Tone Level", "[Goertzel Analyzer]", float, double)
+{
+    const auto frequency = GENERATE(TestType{31.7}, TestType{1000}, TestType{12345.6}, TestType{21000});
+    const auto numSamples = GENERATE(size_t{300}, size_t{4096});
+    constexpr auto sampleRate = TestType{44100};
+    constexpr auto amplitude = .7, phase = 1.1;
+
+    GoertzelAnalyzer<TestType> analyzer{};
+    analyzer.setFrequency(frequency, sampleRate);
+    for (size_t i = 0; i < numSamples; ++i)
+        analyzer.update(static_cast<TestType>(amplitude*std::cos(juce::MathConstants<double>::twoPi*frequency*i/sampleRate+phase)));
+
+    REQUIRE(analyzer.getNumSamples() == numSamples);
+    REQUIRE(analyzer.getAmplitude() == Approx(amplitude).epsilon(1e-3));
+    REQUIRE(analyzer.getPhase() == Approx(phase).epsilon(1e-3));
+
+    analyzer.reset();
+    REQUIRE(analyzer.getAmplitude() == 0);
+}
+
+//Test that other frequencies barely leak into the measurement when it spans whole periods of the tone
+TEST_CASE ("Goertzel Whole Periods", "[Goertzel Analyzer]")
+{
+    constexpr auto sampleRate = 44100.0;
+    const auto frequency = GENERATE(100.0, 997.0, 5000.0);
+    const auto minimumLength = GENERATE(size_t{512}, size_t{4096});
+
+    const auto length = GoertzelAnalyzer<double>::getWholePeriodLength(frequency, sampleRate, minimumLength, 100000);
+    REQUIRE(length >= minimumLength);
+    const auto numPeriods = static_cast<double>(length)*frequency/sampleRate;
+    REQUIRE(numPeriods == Approx(std::round(numPeriods)).margin(.5*frequency/sampleRate));
+
+    //Add a tone 20 times louder that also fits a whole number of periods in the measurement, a few bins away
+    const auto interferingFrequency = frequency+7.0*sampleRate/static_cast<double>(length);
+    GoertzelAnalyzer<double> analyzer{};
+    analyzer.setFrequency(frequency, sampleRate);
+    for (size_t i = 0; i < length; ++i)
+        analyzer.update(std::sin(juce::MathConstants<double>::twoPi*frequency*i/sampleRate)
+                        +20.0*std::sin(juce::MathConstants<double>::twoPi*interferingFrequency*i/sampleRate));
+
+    REQUIRE(analyzer.getAmplitude() == Approx(1.0).epsilon(.01));
+
+    //Periods too long to measure are capped
+    REQUIRE(GoertzelAnalyzer<double>::getWholePeriodLength(1e-9, sampleRate, minimumLength, 100000) == 100000);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+//An allocator that aligns its memory to a given number of bytes, which defaults to a cache line
+// This lets large buffers live on the heap while keeping the alignment that SIMD loads and stores like
+// i.e. std::vector<float, AlignedAllocator<float>>
+template<typename T, size_t Alignment = 64>
+struct AlignedAllocator
+{
+    static_assert(Alignment >= alignof(T), "The alignment can't be smaller than the type's own alignment");
+
+    using value_type = T;
+
+    //Allocators of different types need to be able to make each other, i.e. when a container allocates its own nodes
+    template<typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    constexpr AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t numElements) {
+        return static_cast<T*>(::operator new(numElements*sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* pointer, size_t) noexcept {
+        ::operator delete(pointer, std::align_val_t{Alignment});
+    }
+
+    template<typename U>
+    constexpr bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+    template<typename U>
+    constexpr bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+//A vector whose data is aligned to a cache line
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
@@ -1,9 +1,170 @@
 #pragma once
 
-#include <cstdlib>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+//A counter based random number generator, Philox4x32-10 from Salmon et al's "Parallel Random Numbers: As Easy as 1, 2, 3"
+//Every block of four numbers is a function of just the seed and the block's index, so there's no state carried from one number to the next.
+// This means a buffer can be filled several blocks at a time, side by side,
+// any part of the sequence can be jumped to, and buffers filled in separate chunks are identical to ones filled in one go
+//Each stream is a separate sequence for the same seed, so threads or test cases can each have their own without sharing any state
+class Philox
+{
+public:
+    static constexpr size_t NumbersPerBlock = 4;
+
+    constexpr explicit Philox(uint64_t newSeed = 0, uint64_t newStream = 0) noexcept
+        : key{static_cast<uint32_t>(newSeed), static_cast<uint32_t>(newSeed >> 32)},
+          stream{static_cast<uint32_t>(newStream), static_cast<uint32_t>(newStream >> 32)} {}
+
+    //Get the next number in the sequence
+    uint32_t operator()() noexcept {
+        const auto number = getBlock(position/NumbersPerBlock)[position%NumbersPerBlock];
+        ++position;
+        return number;
+    }
+
+    //Get the next number in the sequence, scaled into the bounds
+    template<typename T>
+    T getBounded(const T& bound1, const T& bound2) noexcept {
+        return scale(operator()(), std::min(bound1, bound2), std::max(bound1, bound2));
+    }
+
+    //Fill a buffer with the next numSamples numbers in the sequence, scaled into the bounds
+    //This gives exactly the same numbers as calling getBounded numSamples times
+    template<typename T>
+    void fill(T* data, size_t numSamples, const T& bound1, const T& bound2) noexcept {
+        const auto min = std::min(bound1, bound2), max = std::max(bound1, bound2);
+        size_t i = 0;
+
+        //Use up the rest of the block the last number came from
+        for (; i < numSamples && position%NumbersPerBlock != 0; ++i)
+            data[i] = scale(operator()(), min, max);
+
+        //Every whole block only depends on its index, so whole batches of blocks can be made at once
+        constexpr auto NumbersPerBatch = BlocksPerBatch*NumbersPerBlock;
+        for (; numSamples-i >= NumbersPerBatch; i += NumbersPerBatch, position += NumbersPerBatch)
+            fillBatch(data+i, position/NumbersPerBlock, min, max);
+
+        for (; numSamples-i >= NumbersPerBlock; i += NumbersPerBlock, position += NumbersPerBlock) {
+            const auto numbers = getBlock(position/NumbersPerBlock);
+            for (size_t j = 0; j < NumbersPerBlock; ++j)
+                data[i+j] = scale(numbers[j], min, max);
+        }
+
+        for (; i < numSamples; ++i)
+            data[i] = scale(operator()(), min, max);
+    }
+
+    //Fill a whole collection, like a vector or an array
+    template<typename Collection, typename T>
+    void fill(Collection& collection, const T& bound1, const T& bound2) noexcept {
+        fill(collection.data(), collection.size(), bound1, bound2);
+    }
+
+    //Jump to any number in the sequence, e.g. to fill the second half of a buffer separately from the first
+    void setPosition(uint64_t newPosition) noexcept { position = newPosition; }
+    uint64_t getPosition() const noexcept { return position; }
+
+    //The four numbers in a block
+    std::array<uint32_t, NumbersPerBlock> getBlock(uint64_t index) const noexcept {
+        std::array<uint32_t, NumbersPerBlock> counter{static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32), stream[0], stream[1]};
+        auto roundKey = key;
+
+        for (auto round = 0; round < 10; ++round) {
+            const auto product0 = static_cast<uint64_t>(multiplier0)*counter[0];
+            const auto product1 = static_cast<uint64_t>(multiplier1)*counter[2];
+            counter = {static_cast<uint32_t>(product1 >> 32)^counter[1]^roundKey[0], static_cast<uint32_t>(product1),
+                       static_cast<uint32_t>(product0 >> 32)^counter[3]^roundKey[1], static_cast<uint32_t>(product0)};
+            roundKey[0] += keyIncrement0;
+            roundKey[1] += keyIncrement1;
+        }
+
+        return counter;
+    }
+
+private:
+    static constexpr uint32_t multiplier0 = 0xD2511F53, multiplier1 = 0xCD9E8D57;
+    static constexpr uint32_t keyIncrement0 = 0x9E3779B9, keyIncrement1 = 0xBB67AE85;
+
+    //How many blocks fill makes at once
+    static constexpr size_t BlocksPerBatch = 8;
+
+    std::array<uint32_t, 2> key;
+    std::array<uint32_t, 2> stream;
+    uint64_t position{0};
+
+    //Make a batch of consecutive blocks, starting at firstBlock, and scale them into the buffer
+    //The same as calling getBlock for each of them, but each of the four numbers in a block is kept in its own array,
+    // so every step of a round is the same operation over a whole array, which the compiler can vectorize across the blocks
+    template<typename T>
+    void fillBatch(T* data, uint64_t firstBlock, const T& min, const T& max) const noexcept {
+        std::array<uint32_t, BlocksPerBatch> counter0, counter1, counter2, counter3;
+        for (size_t block = 0; block < BlocksPerBatch; ++block) {
+            counter0[block] = static_cast<uint32_t>(firstBlock+block);
+            counter1[block] = static_cast<uint32_t>((firstBlock+block) >> 32);
+            counter2[block] = stream[0];
+            counter3[block] = stream[1];
+        }
+
+        auto roundKey = key;
+        for (auto round = 0; round < 10; ++round) {
+            for (size_t block = 0; block < BlocksPerBatch; ++block) {
+                const auto product0 = static_cast<uint64_t>(multiplier0)*counter0[block];
+                const auto product1 = static_cast<uint64_t>(multiplier1)*counter2[block];
+                counter0[block] = static_cast<uint32_t>(product1 >> 32)^counter1[block]^roundKey[0];
+                counter1[block] = static_cast<uint32_t>(product1);
+                counter2[block] = static_cast<uint32_t>(product0 >> 32)^counter3[block]^roundKey[1];
+                counter3[block] = static_cast<uint32_t>(product0);
+            }
+            roundKey[0] += keyIncrement0;
+            roundKey[1] += keyIncrement1;
+        }
+
+        for (size_t block = 0; block < BlocksPerBatch; ++block) {
+            data[block*NumbersPerBlock]   = scale(counter0[block], min, max);
+            data[block*NumbersPerBlock+1] = scale(counter1[block], min, max);
+            data[block*NumbersPerBlock+2] = scale(counter2[block], min, max);
+            data[block*NumbersPerBlock+3] = scale(counter3[block], min, max);
+        }
+    }
+
+    //Scale a number into the bounds, inclusive
+    //Floating point numbers use as many bits as fit in their mantissa, so the scaled numbers are evenly spread
+    //Integers are spread over the bounds with a multiply, so the range between them can be at most 2^32
+    template<typename T>
+    static T scale(uint32_t number, const T& min, const T& max) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            constexpr auto numBits = std::min(std::numeric_limits<T>::digits, 31);
+            constexpr auto largest = static_cast<T>((uint32_t{1} << numBits)-1);
+            //A signed conversion is vectorized on more platforms than an unsigned one
+            const auto unitRandom = static_cast<T>(static_cast<int32_t>(number >> (32-numBits)))/largest;
+            return (max-min)*unitRandom+min;
+        }
+        else {
+            const auto range = static_cast<uint64_t>(max-min)+1;
+            return static_cast<T>(min+static_cast<T>((range*number) >> 32));
+        }
+    }
+};
+
+//The generator getBoundedRandom uses, which every thread has its own copy of, so it's safe to use from any thread
+inline Philox& getThreadRandomGenerator() noexcept {
+    thread_local Philox generator{};
+    return generator;
+}
+
+//Restart the calling thread's random numbers from a seed, so a run of them can be reproduced
+inline void setRandomSeed(uint64_t seed, uint64_t stream = 0) noexcept {
+    getThreadRandomGenerator() = Philox{seed, stream};
+}
 
 //Generates a random number inside of the supplied bounds, inclusive
 template<typename T>
 T getBoundedRandom(const T& bound1, const T& bound2) {
-    return std::abs(bound1-bound2)*(static_cast<T>(std::rand())/static_cast<T>(RAND_MAX))+std::min(bound1, bound2);
-}
\ No newline at end of file
+    return getThreadRandomGenerator().getBounded(bound1, bound2);
+}
@@ -2,6 +2,9 @@
 
 #include "Random.h"
 
+#include <algorithm>
+#include <vector>
+
 //
 TEST_CASE("Noise Generator Perform", "[Noise]") {
     SECTION("Unit Amplitude Random Generation") {
@@ -31,4 +34,77 @@ TEST_CASE("Noise Generator Perform", "[Noise]") {
             CHECK((closeToMin || rand > min));
         }
     }
-}
\ No newline at end of file
+}
+
+//Test the generator against the known answers from the reference implementation of Philox4x32-10
+TEST_CASE("Philox Known Answers", "[Noise]") {
+    using Block = std::array<uint32_t, Philox::NumbersPerBlock>;
+
+    REQUIRE(Philox{}.getBlock(0) == Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+    REQUIRE(Philox{0xffffffffffffffff, 0xffffffffffffffff}.getBlock(0xffffffffffffffff) == Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd});
+    REQUIRE(Philox{0x299f31d0a4093822, 0x0370734413198a2e}.getBlock(0x85a308d3243f6a88) == Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1});
+}
+
+TEMPLATE_TEST_CASE("Philox Reproducible Sequences", "[Noise]", float, double, int) {
+    constexpr size_t numSamples = 1003;
+    const auto bound1 = static_cast<TestType>(-100), bound2 = static_cast<TestType>(100);
+
+    //Numbers drawn one at a time
+    Philox generator{1234, 5};
+    std::vector<TestType> sequential(numSamples);
+    std::generate(sequential.begin(), sequential.end(), [&generator, bound1, bound2] { return generator.getBounded(bound1, bound2); });
+
+    SECTION("Filling a buffer gives the same numbers as drawing them one at a time") {
+        std::vector<TestType> filled(numSamples);
+        Philox{1234, 5}.fill(filled, bound1, bound2);
+        REQUIRE(filled == sequential);
+    }
+
+    SECTION("Filling a buffer in chunks gives the same numbers as filling it in one go") {
+        //Uneven chunk sizes, so the chunks start part of the way through a block
+        std::vector<TestType> chunked(numSamples);
+        Philox chunkGenerator{1234, 5};
+        for (size_t start = 0, chunkSize = 1; start < numSamples; start += chunkSize, chunkSize += 2)
+            chunkGenerator.fill(chunked.data()+start, std::min(chunkSize, numSamples-start), bound1, bound2);
+        REQUIRE(chunked == sequential);
+
+        //Jumping straight to the second half gives the same numbers as getting there from the start
+        std::vector<TestType> secondHalf(numSamples/2);
+        Philox jumpGenerator{1234, 5};
+        jumpGenerator.setPosition(numSamples-secondHalf.size());
+        jumpGenerator.fill(secondHalf, bound1, bound2);
+        REQUIRE(std::equal(secondHalf.begin(), secondHalf.end(), sequential.end()-secondHalf.size()));
+    }
+
+    SECTION("Different seeds and streams give different numbers") {
+        std::vector<TestType> otherSeed(numSamples), otherStream(numSamples);
+        Philox{1235, 5}.fill(otherSeed, bound1, bound2);
+        Philox{1234, 6}.fill(otherStream, bound1, bound2);
+        REQUIRE(otherSeed != sequential);
+        REQUIRE(otherStream != sequential);
+    }
+
+    SECTION("Reseeding the thread's generator repeats its numbers") {
+        setRandomSeed(1234, 5);
+        for (const auto& number : sequential)
+            REQUIRE(getBoundedRandom(bound1, bound2) == number);
+    }
+}
+
+//Test that integers cover every value in the bounds, including the bounds themselves, equally often
+TEST_CASE("Random Integer Distribution", "[Noise]") {
+    constexpr auto min = -3, max = 6;
+    constexpr auto numDraws = 100000;
+    std::array<int, max-min+1> counts{};
+
+    Philox generator{};
+    for (auto i = 0; i < numDraws; ++i) {
+        const auto rand = generator.getBounded(max, min);
+        REQUIRE(rand >= min);
+        REQUIRE(rand <= max);
+        ++counts[static_cast<size_t>(rand-min)];
+    }
+
+    for (const auto& count : counts)
+        CHECK(count == Approx(numDraws/counts.size()).epsilon(.05));
+}